@@ -0,0 +1,7 @@
+--
+DELETE FROM `command` WHERE `name` IN ('server hookprofile start', 'server hookprofile stop', 'server hookprofile reset', 'server hookprofile show');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server hookprofile start', 3, 'Syntax: .server hookprofile start\nStarts counting the calls and the time of every script hook.'),
+('server hookprofile stop',  3, 'Syntax: .server hookprofile stop\nStops counting script hook calls, the results are kept until reset.'),
+('server hookprofile reset', 3, 'Syntax: .server hookprofile reset\nClears the recorded script hook calls.'),
+('server hookprofile show',  3, 'Syntax: .server hookprofile show [#count]\nShows the #count (default 10) script hooks with the most time spent since the last reset.');
@@ -26,6 +26,82 @@ namespace MMAP
     static char const* const MAP_FILE_NAME_FORMAT = "{}/mmaps/{:03}.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "{}/mmaps/{:03}{:02}{:02}.mmtile";
 
+    // ######################## MMapData ########################
+    dtNavMeshQuery* MMapData::AcquireQuery()
+    {
+        {
+            std::lock_guard<std::mutex> guard(queryPoolLock);
+            if (!freeQueries.empty())
+            {
+                dtNavMeshQuery* query = freeQueries.back();
+                freeQueries.pop_back();
+                return query;
+            }
+        }
+
+        // allocate outside of the pool lock, init() allocates the node pool
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+
+        if (dtStatusFailed(query->init(navMesh, NAV_MESH_QUERY_MAX_NODES)))
+        {
+            dtFreeNavMeshQuery(query);
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> guard(queryPoolLock);
+        ++allocatedQueries;
+        return query;
+    }
+
+    void MMapData::ReleaseQuery(dtNavMeshQuery* query)
+    {
+        std::lock_guard<std::mutex> guard(queryPoolLock);
+        freeQueries.push_back(query);
+    }
+
+    // ######################## NavMeshQueryHandle ########################
+    NavMeshQueryHandle::NavMeshQueryHandle(MMapData* data, dtNavMeshQuery* query) :
+        _data(data), _query(query), _lock(data->navMeshLock) { }
+
+    NavMeshQueryHandle::NavMeshQueryHandle(NavMeshQueryHandle&& other) noexcept :
+        _data(other._data), _query(other._query), _lock(std::move(other._lock))
+    {
+        other._data = nullptr;
+        other._query = nullptr;
+    }
+
+    NavMeshQueryHandle& NavMeshQueryHandle::operator=(NavMeshQueryHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            _data = other._data;
+            _query = other._query;
+            _lock = std::move(other._lock);
+            other._data = nullptr;
+            other._query = nullptr;
+        }
+
+        return *this;
+    }
+
+    void NavMeshQueryHandle::Release()
+    {
+        if (_lock.owns_lock())
+        {
+            _lock.unlock();
+        }
+
+        if (_query)
+        {
+            _data->ReleaseQuery(_query);
+        }
+
+        _data = nullptr;
+        _query = nullptr;
+    }
+
     // ######################## MMapMgr ########################
     MMapMgr::~MMapMgr()
     {
@@ -115,7 +191,7 @@ namespace MMAP
         LOG_DEBUG("maps", "MMAP:loadMapData: Loaded {:03}.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, sConfigMgr->GetOption<uint32>("MoveMaps.PathCache.Size", 1024));
         itr->second = mmap_data;
         return true;
     }
@@ -139,7 +215,13 @@ namespace MMAP
 
         // check if we already have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
-        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
+        bool alreadyLoaded;
+        {
+            std::shared_lock<std::shared_mutex> lock(mmap->navMeshLock);
+            alreadyLoaded = mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end();
+        }
+
+        if (alreadyLoaded)
         {
             LOG_ERROR("maps", "MMAP:loadMap: Asked to load already loaded navmesh tile. {:03}{:02}{:02}.mmtile", mapId, x, y);
             return false;
@@ -186,11 +268,15 @@ namespace MMAP
 
         dtTileRef tileRef = 0;
 
+        // no query may run on the navmesh while its tile list changes
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            mmap->pathCache.Invalidate();
             dtMeshHeader* header = (dtMeshHeader*)data;
             LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02},{:02}] into {:03}[{:02},{:02}]", mapId, x, y, mapId, header->x, header->y);
             return true;
@@ -214,6 +300,9 @@ namespace MMAP
 
         MMapData* mmap = itr->second;
 
+        // no query may run on the navmesh while its tile list changes
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
+
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmap->loadedTileRefs.find(packedGridPos) == mmap->loadedTileRefs.end())
@@ -237,6 +326,7 @@ namespace MMAP
 
         mmap->loadedTileRefs.erase(packedGridPos);
         --loadedTiles;
+        mmap->pathCache.Invalidate();
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:03}[{:02},{:02}] from {:03}", mapId, x, y, mapId);
         return true;
     }
@@ -253,6 +343,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> lock(mmap->navMeshLock);
         for (auto& i : mmap->loadedTileRefs)
         {
             uint32 x = (i.first >> 16);
@@ -269,6 +360,7 @@ namespace MMAP
             }
         }
 
+        lock.unlock();
         delete mmap;
         itr->second = nullptr;
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded {:03}.mmap", mapId);
@@ -276,74 +368,56 @@ namespace MMAP
         return true;
     }
 
-    bool MMapMgr::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapMgr::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
         {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map {:03}", mapId);
-            return false;
+            return nullptr;
         }
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        return itr->second->navMesh;
+    }
+
+    uint32 MMapMgr::getNavMeshQueryCount(uint32 mapId) const
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
         {
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId {:03} instanceId {}", mapId, instanceId);
-            return false;
+            return 0;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId {:03} instanceId {}", mapId, instanceId);
-
-        return true;
+        std::lock_guard<std::mutex> guard(itr->second->queryPoolLock);
+        return itr->second->allocatedQueries;
     }
 
-    dtNavMesh const* MMapMgr::GetNavMesh(uint32 mapId)
+    PathCacheStats MMapMgr::getPathCacheStats(uint32 mapId) const
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
         {
-            return nullptr;
+            return PathCacheStats();
         }
 
-        return itr->second->navMesh;
+        return itr->second->pathCache.GetStats();
     }
 
-    dtNavMeshQuery const* MMapMgr::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    NavMeshQueryHandle MMapMgr::AcquireNavMeshQuery(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
         {
-            return nullptr;
+            return NavMeshQueryHandle();
         }
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        dtNavMeshQuery* query = mmap->AcquireQuery();
+        if (!query)
         {
-            // check again after acquiring mutex
-            if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-            {
-                // allocate mesh query
-                dtNavMeshQuery* query = dtAllocNavMeshQuery();
-                ASSERT(query);
-
-                if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-                {
-                    dtFreeNavMeshQuery(query);
-                    LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                    return nullptr;
-                }
-
-                LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-            }
+            LOG_ERROR("maps", "MMAP:AcquireNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03}", mapId);
+            return NavMeshQueryHandle();
         }
 
-        return mmap->navMeshQueries[instanceId];
+        return NavMeshQueryHandle(mmap, query);
     }
 }
@@ -22,6 +22,10 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include "PathCache.h"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -41,21 +45,22 @@ namespace MMAP
 {
     // 定义地图瓦片集合类型，键为 uint32 类型，值为 dtTileRef 类型
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    // 定义导航网格查询集合类型，键为 uint32 类型，值为 dtNavMeshQuery* 类型
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+
+    // 每个查询对象可搜索的最大节点数
+    static constexpr int32 NAV_MESH_QUERY_MAX_NODES = 1024;
 
     // 用于保存地图的移动地图数据的结构体
     struct MMapData
     {
-        // 构造函数，初始化导航网格指针
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        // 构造函数，初始化导航网格指针和路径缓存的容量
+        MMapData(dtNavMesh* mesh, uint32 pathCacheSize) : navMesh(mesh), pathCache(pathCacheSize) { }
 
-        // 析构函数，释放导航网格查询和导航网格占用的内存
+        // 析构函数，释放查询池和导航网格占用的内存
         ~MMapData()
         {
-            for (auto& navMeshQuerie : navMeshQueries)
+            for (dtNavMeshQuery* query : freeQueries)
             {
-                dtFreeNavMeshQuery(navMeshQuerie.second);
+                dtFreeNavMeshQuery(query);
             }
 
             if (navMesh)
@@ -64,15 +69,59 @@ namespace MMAP
             }
         }
 
-        // 由于 dtNavMeshQuery 不是线程安全的，每个实例需要单独使用一个
-        NavMeshQuerySet navMeshQueries; // 实例 ID 到查询对象的映射
+        // 从池中取出一个空闲的查询对象，池为空时分配新的对象
+        dtNavMeshQuery* AcquireQuery();
+        // 将查询对象归还到池中
+        void ReleaseQuery(dtNavMeshQuery* query);
+
         dtNavMesh* navMesh;             // 导航网格指针
         MMapTileSet loadedTileRefs;     // 地图网格坐标到 dtTile 的映射
+
+        // 查询期间持有共享锁，加载/卸载瓦片时持有独占锁
+        std::shared_mutex navMeshLock;
+
+        // 由于 dtNavMeshQuery 不是线程安全的，每个线程在使用期间独占一个查询对象
+        std::mutex queryPoolLock;
+        std::vector<dtNavMeshQuery*> freeQueries; // 空闲的查询对象
+        uint32 allocatedQueries{0};               // 已分配的查询对象总数
+
+        // 按多边形缓存的 findPath 结果，瓦片变化时清空
+        PathCache pathCache;
     };
 
     // 定义移动地图数据集合类型，键为 uint32 类型，值为 MMapData* 类型
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    // 从查询池中借出的导航网格查询对象
+    // 持有期间导航网格不会加载或卸载瓦片，析构时自动归还到池中
+    class NavMeshQueryHandle
+    {
+    public:
+        NavMeshQueryHandle() = default;
+        NavMeshQueryHandle(MMapData* data, dtNavMeshQuery* query);
+        ~NavMeshQueryHandle() { Release(); }
+
+        NavMeshQueryHandle(NavMeshQueryHandle const&) = delete;
+        NavMeshQueryHandle& operator=(NavMeshQueryHandle const&) = delete;
+        NavMeshQueryHandle(NavMeshQueryHandle&& other) noexcept;
+        NavMeshQueryHandle& operator=(NavMeshQueryHandle&& other) noexcept;
+
+        // 提前归还查询对象并释放导航网格的共享锁
+        void Release();
+
+        [[nodiscard]] dtNavMeshQuery const* get() const { return _query; }
+        [[nodiscard]] dtNavMesh const* GetNavMesh() const { return _data ? _data->navMesh : nullptr; }
+        // 地图的路径缓存，持有期间缓存的多边形引用保持有效
+        [[nodiscard]] PathCache* GetPathCache() const { return _data ? &_data->pathCache : nullptr; }
+        dtNavMeshQuery const* operator->() const { return _query; }
+        explicit operator bool() const { return _query != nullptr; }
+
+    private:
+        MMapData* _data{nullptr};
+        dtNavMeshQuery* _query{nullptr};
+        std::shared_lock<std::shared_mutex> _lock;
+    };
+
     // 单例类
     // 负责所有移动地图的加载、卸载和网格访问操作
     class MMapMgr
@@ -89,13 +138,12 @@ namespace MMAP
         bool loadMap(uint32 mapId, int32 x, int32 y);
         // 卸载指定地图和坐标的移动地图
         bool unloadMap(uint32 mapId, int32 x, int32 y);
-        // 卸载指定地图的所有移动地图
+        // 卸载指定地图的所有移动地图，调用时不能有借出的查询对象
         bool unloadMap(uint32 mapId);
-        // 卸载指定地图和实例 ID 的移动地图
-        bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-        // 获取指定地图和实例 ID 的导航网格查询对象，返回的对象不是线程安全的
-        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+        // 从指定地图的查询池中借出一个查询对象，可在任意线程调用
+        // 地图未加载时返回空的句柄
+        NavMeshQueryHandle AcquireNavMeshQuery(uint32 mapId);
         // 获取指定地图的导航网格
         dtNavMesh const* GetNavMesh(uint32 mapId);
 
@@ -103,6 +151,10 @@ namespace MMAP
         [[nodiscard]] uint32 getLoadedTilesCount() const { return loadedTiles; }
         // 获取已加载的地图数量
         [[nodiscard]] uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+        // 获取指定地图的查询池已分配的查询对象数量
+        [[nodiscard]] uint32 getNavMeshQueryCount(uint32 mapId) const;
+        // 获取指定地图的路径缓存统计数据
+        [[nodiscard]] PathCacheStats getPathCacheStats(uint32 mapId) const;
 
     private:
         // 加载指定地图的移动地图数据
@@ -115,7 +167,7 @@ namespace MMAP
         // 已加载的移动地图数据集合
         MMapDataSet loadedMMaps;
         // 已加载的瓦片数量
-        uint32 loadedTiles{0};
+        std::atomic<uint32> loadedTiles{0};
         // 是否处于线程安全的环境
         bool thread_safe_environment{true};
     };
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace MMAP
+{
+    std::size_t PathCacheKeyHash::operator()(PathCacheKey const& key) const
+    {
+        std::size_t hash = std::hash<dtPolyRef>()(key.startPoly);
+        hash ^= std::hash<dtPolyRef>()(key.endPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32>()(uint32(key.includeFlags) << 16 | key.excludeFlags) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    bool PathCache::Find(PathCacheKey const& key, dtPolyRef* path, uint32& pathLength, uint32 maxPath)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = _index.find(key);
+        if (itr == _index.end() || itr->second->path.size() > maxPath)
+        {
+            ++_stats.misses;
+            return false;
+        }
+
+        // move to the front of the lru list
+        _entries.splice(_entries.begin(), _entries, itr->second);
+
+        Entry const& entry = *itr->second;
+        std::copy(entry.path.begin(), entry.path.end(), path);
+        pathLength = uint32(entry.path.size());
+
+        ++_stats.hits;
+        _stats.savedMicros += entry.computeMicros;
+        return true;
+    }
+
+    void PathCache::Insert(PathCacheKey const& key, dtPolyRef const* path, uint32 pathLength, uint64 computeMicros)
+    {
+        if (!_capacity || !pathLength)
+            return;
+
+        std::lock_guard<std::mutex> guard(_lock);
+
+        // another thread calculated the same path meanwhile
+        auto itr = _index.find(key);
+        if (itr != _index.end())
+        {
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            return;
+        }
+
+        if (_entries.size() >= _capacity)
+        {
+            // reuse the least recently used entry
+            _index.erase(_entries.back().key);
+            _entries.splice(_entries.begin(), _entries, std::prev(_entries.end()));
+        }
+        else
+            _entries.emplace_front();
+
+        Entry& entry = _entries.front();
+        entry.key = key;
+        entry.path.assign(path, path + pathLength);
+        entry.computeMicros = computeMicros;
+        _index[key] = _entries.begin();
+    }
+
+    void PathCache::Invalidate()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        if (_entries.empty())
+            return;
+
+        _index.clear();
+        _entries.clear();
+        ++_stats.invalidations;
+    }
+
+    PathCacheStats PathCache::GetStats() const
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        PathCacheStats stats = _stats;
+        stats.size = uint32(_entries.size());
+        return stats;
+    }
+}
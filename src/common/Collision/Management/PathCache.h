@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_PATH_CACHE_H
+#define _MMAP_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    // 路径缓存的键：起点多边形、终点多边形和过滤器标志
+    struct PathCacheKey
+    {
+        dtPolyRef startPoly;
+        dtPolyRef endPoly;
+        uint16 includeFlags;
+        uint16 excludeFlags;
+
+        bool operator==(PathCacheKey const& other) const
+        {
+            return startPoly == other.startPoly && endPoly == other.endPoly &&
+                includeFlags == other.includeFlags && excludeFlags == other.excludeFlags;
+        }
+    };
+
+    struct PathCacheKeyHash
+    {
+        std::size_t operator()(PathCacheKey const& key) const;
+    };
+
+    // 路径缓存的统计数据
+    struct PathCacheStats
+    {
+        uint64 hits{0};             // 命中次数
+        uint64 misses{0};           // 未命中次数
+        uint64 savedMicros{0};      // 命中时节省的 findPath 耗时总和（微秒）
+        uint32 invalidations{0};    // 因瓦片加载/卸载清空缓存的次数
+        uint32 size{0};             // 当前缓存的路径数量
+
+        // 命中率，0 到 1
+        [[nodiscard]] float GetHitRate() const { return (hits + misses) ? float(hits) / float(hits + misses) : 0.0f; }
+        // 每次命中平均节省的时间（微秒）
+        [[nodiscard]] uint64 GetAverageSavedMicros() const { return hits ? savedMicros / hits : 0; }
+    };
+
+    // 按多边形缓存 findPath 结果的 LRU 缓存，每个地图一个，可在任意线程使用
+    // 只缓存完整到达终点多边形的路径，瓦片加载或卸载时整体清空
+    class PathCache
+    {
+    public:
+        explicit PathCache(uint32 capacity) : _capacity(capacity) { }
+
+        PathCache(PathCache const&) = delete;
+        PathCache& operator=(PathCache const&) = delete;
+
+        // 是否启用了缓存
+        [[nodiscard]] bool IsEnabled() const { return _capacity != 0; }
+
+        // 查找缓存的路径，命中时复制到 path 并返回 true
+        // 缓存的路径长于 maxPath 时视为未命中
+        bool Find(PathCacheKey const& key, dtPolyRef* path, uint32& pathLength, uint32 maxPath);
+        // 缓存 findPath 的结果，computeMicros 为计算该路径的耗时
+        void Insert(PathCacheKey const& key, dtPolyRef const* path, uint32 pathLength, uint64 computeMicros);
+        // 清空缓存，在导航网格的瓦片变化时调用
+        void Invalidate();
+
+        // 获取统计数据
+        [[nodiscard]] PathCacheStats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            PathCacheKey key;
+            std::vector<dtPolyRef> path;
+            uint64 computeMicros;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        uint32 const _capacity;
+        mutable std::mutex _lock;
+        EntryList _entries;     // 最近使用的在前
+        std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> _index;
+        PathCacheStats _stats;
+    };
+}
+
+#endif
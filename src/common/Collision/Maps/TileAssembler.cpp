@@ -18,13 +18,17 @@
 // 包含头文件
 #include "TileAssembler.h"
 #include "BoundingIntervalHierarchy.h"
+#include "DataManifest.h"
 #include "MapDefines.h"
 #include "MapTree.h"
 #include "VMapDefinitions.h"
 #include <boost/filesystem.hpp>
+#include <atomic>
 #include <iomanip>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 // 使用命名空间中的类型
 using G3D::Vector3;
@@ -63,8 +67,8 @@ namespace VMAP
     //=================================================================
 
     // TileAssembler 构造函数，初始化源目录和目标目录
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iThreads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
     {
         // 创建目标目录
         boost::filesystem::create_directory(iDestDir);
@@ -172,6 +176,7 @@ namespace VMAP
             }
 
             fclose(mapfile);
+            writtenFiles.push_back(boost::filesystem::path(mapfilename.str()).filename().string());
 
             // <====
 
@@ -214,6 +219,7 @@ namespace VMAP
                         if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) { success = false; }
                     }
                     fclose(tilefile);
+                    writtenFiles.push_back(boost::filesystem::path(tilefilename.str()).filename().string());
                 }
             }
             // break; //test, extract only first map; TODO: remvoe this line
@@ -222,16 +228,9 @@ namespace VMAP
         // 添加临时游戏对象模型文件中列出的对象模型
         exportGameobjectModels();
         // 导出对象
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        if (!convertModelFiles())
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            success = false;
         }
 
         // 清理资源
@@ -422,6 +421,112 @@ namespace VMAP
         return success;
     }
 
+    // 并行转换模型文件
+    bool TileAssembler::convertModelFiles()
+    {
+        // 上次转换的清单，输入未变化的模型文件不再转换
+        std::string manifestPath = iDestDir + "/" + DataManifest::FILE_NAME;
+        DataManifest previousManifest;
+        previousManifest.Load(manifestPath);
+
+        DataManifest manifest;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::atomic<std::size_t> nextModel = 0;
+        std::atomic<uint32> converted = 0, skipped = 0;
+        std::atomic<bool> success = true;
+        std::mutex logLock;
+
+        std::cout << "\nConverting " << modelFiles.size() << " Model Files using " << iThreads << " threads" << std::endl;
+
+        auto worker = [&]()
+        {
+            for (std::size_t i = nextModel++; i < modelFiles.size() && success; i = nextModel++)
+            {
+                std::string const& modelFile = modelFiles[i];
+                std::string outputFile = modelFile + ".vmo";
+                std::string outputPath = iDestDir + "/" + outputFile;
+
+                // 输入文件的哈希中包含 vmap 格式版本，格式变化时全部重新转换
+                std::string sourceHash = DataManifest::HashFile(iSrcDir + "/" + modelFile) + VMAP_MAGIC;
+                if (DataManifest::Entry const* entry = previousManifest.Find(outputFile))
+                {
+                    boost::system::error_code error;
+                    if (entry->SourceHash == sourceHash && boost::filesystem::file_size(outputPath, error) == entry->Size && !error)
+                    {
+                        manifest.Set(outputFile, *entry);
+                        ++skipped;
+                        continue;
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> guard(logLock);
+                    std::cout << "Converting " << modelFile << std::endl;
+                }
+
+                if (!convertRawFile(modelFile))
+                {
+                    std::lock_guard<std::mutex> guard(logLock);
+                    std::cout << "error converting " << modelFile << std::endl;
+                    success = false;
+                    break;
+                }
+
+                DataManifest::Entry entry;
+                entry.Size = boost::filesystem::file_size(outputPath);
+                entry.Hash = DataManifest::HashFile(outputPath);
+                entry.SourceHash = sourceHash;
+                manifest.Set(outputFile, entry);
+                ++converted;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32 i = 1; i < iThreads; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (!success)
+        {
+            return false;
+        }
+
+        std::cout << "Converted " << converted << " model files, " << skipped << " unchanged files skipped" << std::endl;
+
+        // 地图树和瓦片文件每次都重新生成，只记录其内容供 worldserver 校验
+        writtenFiles.push_back(GAMEOBJECT_MODELS);
+        for (std::string const& file : writtenFiles)
+        {
+            std::string path = iDestDir + "/" + file;
+            boost::system::error_code error;
+            uint64 size = boost::filesystem::file_size(path, error);
+            if (error)
+            {
+                continue;
+            }
+
+            DataManifest::Entry entry;
+            entry.Size = size;
+            entry.Hash = DataManifest::HashFile(path);
+            manifest.Set(file, entry);
+        }
+
+        if (!manifest.Save(manifestPath))
+        {
+            std::cout << "Cannot write " << manifestPath << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
     // 导出游戏对象模型
     void TileAssembler::exportGameobjectModels()
     {
@@ -22,6 +22,7 @@
 #include <G3D/Vector3.h>
 #include <map>
 #include <set>
+#include <vector>
 
 #include "ModelInstance.h"
 #include "WorldModel.h"
@@ -132,10 +133,14 @@ namespace VMAP
         MapData mapData;
         // 已生成的模型文件集合
         std::set<std::string> spawnedModelFiles;
+        // 本次写入的地图树和瓦片文件，记录到清单中
+        std::vector<std::string> writtenFiles;
+        // 转换模型文件的线程数
+        uint32 iThreads;
 
     public:
-        // 构造函数，初始化源目录和目标目录
-        TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+        // 构造函数，初始化源目录和目标目录，threads 为 0 时使用全部 CPU 核心
+        TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, uint32 threads = 0);
         // 析构函数
         virtual ~TileAssembler();
 
@@ -150,6 +155,8 @@ namespace VMAP
 
         // 转换原始文件
         bool convertRawFile(const std::string& pModelFilename);
+        // 并行转换所有模型文件，跳过输入与上次转换相同的文件，并写入清单
+        bool convertModelFiles();
     };
 
 }                                                           // VMAP
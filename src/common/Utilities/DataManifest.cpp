@@ -0,0 +1,160 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DataManifest.h"
+#include "CryptoHash.h"
+#include "StringFormat.h"
+#include "Util.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    constexpr char const* MANIFEST_HEADER = "# AzerothCore data manifest v1";
+    constexpr char const* NO_SOURCE_HASH = "-";
+}
+
+bool DataManifest::Load(std::string const& path)
+{
+    std::ifstream input(path);
+    std::string line;
+    if (!input || !std::getline(input, line) || line != MANIFEST_HEADER)
+        return false;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _entries.clear();
+
+    while (std::getline(input, line))
+    {
+        std::istringstream fields(line);
+        std::string file;
+        Entry entry;
+        if (!(fields >> file >> entry.Size >> entry.Hash >> entry.SourceHash))
+            continue;
+
+        if (entry.SourceHash == NO_SOURCE_HASH)
+            entry.SourceHash.clear();
+
+        _entries[file] = std::move(entry);
+    }
+
+    return true;
+}
+
+bool DataManifest::Save(std::string const& path) const
+{
+    // never leave a half written manifest behind
+    std::string tempPath = path + ".tmp";
+    FILE* output = fopen(tempPath.c_str(), "w");
+    if (!output)
+        return false;
+
+    fprintf(output, "%s\n", MANIFEST_HEADER);
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        for (auto const& [file, entry] : _entries)
+            fprintf(output, "%s %llu %s %s\n", file.c_str(), (unsigned long long)entry.Size, entry.Hash.c_str(),
+                entry.SourceHash.empty() ? NO_SOURCE_HASH : entry.SourceHash.c_str());
+    }
+
+    bool success = fflush(output) == 0;
+    success = fclose(output) == 0 && success;
+    if (!success)
+        return false;
+
+    std::remove(path.c_str());
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+DataManifest::Entry const* DataManifest::Find(std::string const& file) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // entries are never removed, the pointer stays valid
+    auto itr = _entries.find(file);
+    return itr != _entries.end() ? &itr->second : nullptr;
+}
+
+void DataManifest::Set(std::string const& file, Entry const& entry)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _entries[file] = entry;
+}
+
+std::size_t DataManifest::GetSize() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _entries.size();
+}
+
+uint32 DataManifest::Verify(std::string const& directory, bool checkHash, std::vector<std::string>& errors) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    uint32 mismatches = 0;
+    for (auto const& [file, entry] : _entries)
+    {
+        std::string path = directory + "/" + file;
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        if (!input)
+        {
+            ++mismatches;
+            errors.push_back(Acore::StringFormat("{} is missing", path));
+            continue;
+        }
+
+        uint64 size = uint64(input.tellg());
+        input.close();
+
+        if (size != entry.Size)
+        {
+            ++mismatches;
+            errors.push_back(Acore::StringFormat("{} has size {}, expected {}", path, size, entry.Size));
+            continue;
+        }
+
+        if (checkHash && HashFile(path) != entry.Hash)
+        {
+            ++mismatches;
+            errors.push_back(Acore::StringFormat("{} content does not match the manifest", path));
+        }
+    }
+
+    return mismatches;
+}
+
+std::string DataManifest::HashFile(std::string const& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+        return "";
+
+    Acore::Crypto::SHA256 hash;
+    char buffer[64 * 1024];
+    while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0)
+        hash.UpdateData(reinterpret_cast<uint8 const*>(buffer), std::size_t(input.gcount()));
+
+    hash.Finalize();
+    return ByteArrayToHexStr(hash.GetDigest());
+}
+
+std::string DataManifest::HashData(uint8 const* data, std::size_t size)
+{
+    return ByteArrayToHexStr(Acore::Crypto::SHA256::GetDigestOf(data, size));
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATA_MANIFEST_H
+#define _DATA_MANIFEST_H
+
+#include "Define.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 提取工具生成的数据文件清单
+// 记录每个输出文件的大小、内容哈希以及生成它的输入数据的哈希，
+// 提取工具据此跳过输入未变化的文件，worldserver 启动时可据此校验数据目录
+class AC_COMMON_API DataManifest
+{
+public:
+    // 清单在数据子目录（maps、vmaps）中的文件名
+    static constexpr char const* FILE_NAME = "manifest.txt";
+
+    struct Entry
+    {
+        uint64 Size = 0;            // 输出文件大小
+        std::string Hash;           // 输出文件的 SHA256
+        std::string SourceHash;     // 输入数据和转换参数的 SHA256
+    };
+
+    DataManifest() = default;
+    DataManifest(DataManifest const&) = delete;
+    DataManifest& operator=(DataManifest const&) = delete;
+
+    // 读取清单文件，文件不存在或格式不匹配时返回 false
+    bool Load(std::string const& path);
+    // 写入清单文件
+    bool Save(std::string const& path) const;
+
+    // 查找文件的记录，file 为相对于清单所在目录的路径
+    [[nodiscard]] Entry const* Find(std::string const& file) const;
+    // 添加或替换文件的记录，可在多个线程中调用
+    void Set(std::string const& file, Entry const& entry);
+    // 记录数量
+    [[nodiscard]] std::size_t GetSize() const;
+
+    // 校验 directory 中的文件是否与清单一致，checkHash 为 false 时只比较文件大小
+    // 返回不一致的文件数量，errors 中为具体的错误信息
+    uint32 Verify(std::string const& directory, bool checkHash, std::vector<std::string>& errors) const;
+
+    // 计算文件内容的 SHA256，文件无法读取时返回空字符串
+    static std::string HashFile(std::string const& path);
+    // 计算数据的 SHA256
+    static std::string HashData(uint8 const* data, std::size_t size);
+
+private:
+    mutable std::mutex _lock;
+    std::map<std::string, Entry> _entries;
+};
+
+#endif
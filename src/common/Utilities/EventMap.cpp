@@ -20,7 +20,7 @@
 
 void EventMap::Reset()
 {
-    _eventMap.clear();
+    _eventMap.Clear();
     _time = 0;
     _phase = 0;
 }
@@ -65,7 +65,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
         eventId |= (1 << (phase + 23));
     }
 
-    _eventMap.emplace(_time + time, eventId);
+    _eventMap.Push(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*= 0*/, uint8 phase /* = 0*/)
@@ -98,7 +98,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::RepeatEvent(uint32 time)
 {
-    _eventMap.emplace(_time + time, _lastEvent);
+    _eventMap.Push(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds time)
@@ -115,22 +115,20 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        auto const& itr = _eventMap.begin();
+        EventStore::Node const& next = _eventMap.Top();
 
-        if (itr->first > _time)
+        if (next.time > _time)
         {
             return 0;
         }
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
+        else if (_phase && (next.value & 0xFF000000) && !((next.value >> 24) & _phase))
         {
-            _eventMap.erase(itr);
+            _eventMap.Pop();
         }
         else
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second;
-            _eventMap.erase(itr);
-            return eventId;
+            _lastEvent = _eventMap.Pop();
+            return (_lastEvent & 0x0000FFFF);
         }
     }
 
@@ -154,37 +152,27 @@ void EventMap::DelayEvents(uint32 delay, uint32 group)
         return;
     }
 
-    EventStore delayed;
-
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    // the delayed events are queued again in their order, behind the events already due at their new time
+    std::vector<EventStore::Node> delayed;
+    _eventMap.ExtractIf([group](EventStore::Node const& node)
     {
-        if (!group || (itr->second & (1 << (group + 15))))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            itr = _eventMap.erase(itr);
-            continue;
-        }
+        return !group || (node.value & (1 << (group + 15)));
+    }, delayed);
 
-        ++itr;
-    }
-
-    _eventMap.insert(delayed.begin(), delayed.end());
+    for (EventStore::Node const& node : delayed)
+        _eventMap.Push(node.time + delay, node.value);
 }
 
 void EventMap::DelayEventsToMax(uint32 delay, uint32 group)
 {
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    std::vector<EventStore::Node> delayed;
+    _eventMap.ExtractIf([this, delay, group](EventStore::Node const& node)
     {
-        if (itr->first < _time + delay && (group == 0 || ((1 << (group + 15)) & itr->second)))
-        {
-            ScheduleEvent(itr->second, delay);
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
+        return node.time < _time + delay && (group == 0 || ((1 << (group + 15)) & node.value));
+    }, delayed);
 
-        ++itr;
-    }
+    for (EventStore::Node const& node : delayed)
+        ScheduleEvent(node.value, delay);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -194,16 +182,10 @@ void EventMap::CancelEvent(uint32 eventId)
         return;
     }
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.RemoveIf([eventId](EventStore::Node const& node)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
-        {
-            itr = _eventMap.erase(itr);
-            continue;
-        }
-
-        ++itr;
-    }
+        return eventId == (node.value & 0x0000FFFF);
+    });
 }
 
 void EventMap::CancelEventGroup(uint32 group)
@@ -214,17 +196,10 @@ void EventMap::CancelEventGroup(uint32 group)
     }
 
     uint32 groupMask = (1 << (group + 15));
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
+    _eventMap.RemoveIf([groupMask](EventStore::Node const& node)
     {
-        if (itr->second & groupMask)
-        {
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
-
-        ++itr;
-    }
+        return node.value & groupMask;
+    });
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -234,20 +209,17 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
         return 0;
     }
 
-    for (auto const& itr : _eventMap)
+    EventStore::Node const* next = _eventMap.FindFirst([eventId](EventStore::Node const& node)
     {
-        if (eventId == (itr.second & 0x0000FFFF))
-        {
-            return itr.first;
-        }
-    }
+        return eventId == (node.value & 0x0000FFFF);
+    });
 
-    return 0;
+    return next ? next->time : 0;
 }
 
 uint32 EventMap::GetNextEventTime() const
 {
-    return Empty() ? 0 : _eventMap.begin()->first;
+    return Empty() ? 0 : _eventMap.Top().time;
 }
 
 bool EventMap::IsInPhase(uint8 phase)
@@ -257,9 +229,13 @@ bool EventMap::IsInPhase(uint8 phase)
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<uint32 const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr.first) - Milliseconds(_time));
+    EventStore::Node const* next = _eventMap.FindFirst([eventId](EventStore::Node const& node)
+    {
+        return eventId == (node.value & 0x0000FFFF);
+    });
+
+    if (next)
+        return std::chrono::duration_cast<Milliseconds>(Milliseconds(next->time) - Milliseconds(_time));
 
     return Milliseconds::max();
 }
@@ -20,7 +20,7 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include "TimerQueue.h"
 
 class EventMap
 {
@@ -35,7 +35,7 @@ class EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    typedef TimerQueue<uint32, uint32> EventStore;
 
 public:
     EventMap() { }
@@ -95,7 +95,7 @@ public:
     */
     [[nodiscard]] bool Empty() const
     {
-        return _eventMap.empty();
+        return _eventMap.IsEmpty();
     }
 
     /**
@@ -43,12 +43,10 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_events.IsEmpty() && m_events.Top().time <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        BasicEvent* event = m_events.Pop();
 
         if (event->IsRunning())
         {
@@ -81,56 +79,68 @@ void EventProcessor::Update(uint32 p_time)
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    std::vector<EventList::Node> events;
+    events.swap(m_eventBuffer);
+    std::vector<EventList::Node> kept;
+
+    // take the events out in queue order, aborting them may queue new events which are killed as well
+    while (!m_events.IsEmpty())
     {
-        // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
-        {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
-        }
+        m_events.TakeAll(events);
 
-        // Skip non-deletable events when we are
-        // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        // first, abort all existing events
+        for (EventList::Node& node : events)
         {
-            ++itr;
-            continue;
-        }
+            // Abort events which weren't aborted already
+            if (!node.value->IsAborted())
+            {
+                node.value->SetAborted();
+                node.value->Abort(m_time);
+            }
+
+            // Skip non-deletable events when we are
+            // not forcing the event cancellation.
+            if (!force && !node.value->IsDeletable())
+            {
+                kept.push_back(std::move(node));
+                continue;
+            }
 
-        delete itr->second;
+            delete node.value;
+        }
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        events.clear();
     }
 
-    if (force)
-        m_events.clear();
+    for (EventList::Node& node : kept)
+        m_events.Reinsert(std::move(node));
+
+    m_eventBuffer.swap(events);
 }
 
 void EventProcessor::CancelEventGroup(uint8 group)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    std::vector<EventList::Node> events;
+    events.swap(m_eventBuffer);
+    m_events.ExtractIf([group](EventList::Node const& node)
     {
-        if (itr->second->m_eventGroup != group)
-        {
-            ++itr;
-            continue;
-        }
+        return node.value->m_eventGroup == group;
+    }, events);
 
+    for (EventList::Node& node : events)
+    {
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!node.value->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            node.value->SetAborted();
+            node.value->Abort(m_time);
         }
 
-        delete itr->second;
-        itr = m_events.erase(itr);
+        delete node.value;
     }
+
+    events.clear();
+    m_eventBuffer.swap(events);
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime, uint8 eventGroup)
@@ -139,20 +149,16 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
     Event->m_eventGroup = eventGroup;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    m_events.Push(e_time, Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
+    // the event is queued again behind the events already due at the new time
+    if (m_events.RemoveIf([event](EventList::Node const& node) { return node.value == event; }))
     {
-        if (itr->second != event)
-            continue;
-
         event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
-        break;
+        m_events.Push(newTime.count(), event);
     }
 }
 
@@ -21,7 +21,7 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include "TimerQueue.h"
 
 class EventProcessor;
 
@@ -90,7 +90,7 @@ class LambdaBasicEvent : public BasicEvent
 template<typename T>
 using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::remove_pointer_t<std::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+typedef TimerQueue<uint64, BasicEvent*> EventList;
 
 class EventProcessor
 {
@@ -100,6 +100,7 @@ class EventProcessor
 
         void Update(uint32 p_time);
         void KillAllEvents(bool force);
+        [[nodiscard]] bool Empty() const { return m_events.IsEmpty(); }
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true) { AddEvent(Event, e_time, set_addtime, 0); };
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime, uint8 eventGroup);
         template<typename T>
@@ -125,6 +126,7 @@ class EventProcessor
     protected:
         uint64 m_time{0};
         EventList m_events;
+        std::vector<EventList::Node> m_eventBuffer;             // reused while events are taken out of the queue
         bool m_aborting;
 };
 
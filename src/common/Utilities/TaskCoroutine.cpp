@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskCoroutine.h"
+#include "Errors.h"
+#include <algorithm>
+
+TaskCoroutine& TaskCoroutine::operator= (TaskCoroutine&& right) noexcept
+{
+    if (this != &right)
+    {
+        if (_handle)
+            _handle.destroy();
+
+        _handle = std::exchange(right._handle, nullptr);
+    }
+
+    return *this;
+}
+
+TaskCoroutine::~TaskCoroutine()
+{
+    if (_handle)
+        _handle.destroy();
+}
+
+TaskCoroutine::Frame::~Frame()
+{
+    _handle.destroy();
+}
+
+void TaskCoroutine::Frame::Resume(TaskContext& context)
+{
+    promise_type& promise = _handle.promise();
+    promise._context = &context;
+    _handle.resume();
+    promise._context = nullptr;
+}
+
+TaskScheduler::task_handler_t TaskCoroutine::Resumer(FramePtr frame)
+{
+    return [frame = std::move(frame)](TaskContext context)
+    {
+        frame->Resume(context);
+    };
+}
+
+TaskScheduler::TaskContainer TaskCoroutine::Launch(TaskScheduler::timepoint_t const& now, std::optional<TaskScheduler::group_t> const& group)
+{
+    ASSERT(_handle, "TaskCoroutine was started already");
+
+    FramePtr frame = std::make_shared<Frame>(std::exchange(_handle, nullptr));
+    frame->GetHandle().promise()._frame = frame;
+    return TaskScheduler::TaskContainer(new TaskScheduler::Task(now, TaskScheduler::duration_t::zero(), group, 0, Resumer(std::move(frame))));
+}
+
+void TaskCoroutine::WaitAwaiter::await_suspend(handle_t handle)
+{
+    promise_type& promise = handle.promise();
+    ASSERT(promise._context, "TaskCoroutine awaited outside of its scheduler");
+
+    TaskContext& context = *promise._context;
+    FramePtr frame = promise._frame.lock();
+
+    if (!_condition)
+    {
+        // in-context timing, the same as TaskContext::Schedule but within the group of the coroutine
+        TaskScheduler::TaskContainer task = context.Continue(_time, Resumer(std::move(frame)));
+        context.Dispatch([task](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTask(task);
+        });
+        return;
+    }
+
+    // checks the condition every interval, the coroutine stays suspended meanwhile.
+    // The checks are timed from the update time instead of from when the coroutine was due,
+    // so a late update checks the condition once instead of catching up on every missed interval
+    TaskScheduler::duration_t const interval = _time;
+    TaskScheduler::TaskContainer task = context.Continue(interval, [frame, condition = std::move(_condition), interval](TaskContext context)
+    {
+        if (condition())
+        {
+            frame->Resume(context);
+            return;
+        }
+
+        context.Dispatch([task = context._task, interval](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTaskAfter(task, interval);
+        });
+    });
+
+    context.Dispatch([task, interval](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        return scheduler.InsertTaskAfter(task, interval);
+    });
+}
+
+void TaskSignal::Awaiter::await_suspend(TaskCoroutine::handle_t handle)
+{
+    TaskCoroutine::promise_type& promise = handle.promise();
+    ASSERT(promise._context, "TaskCoroutine awaited outside of its scheduler");
+
+    TaskContext& context = *promise._context;
+    TaskScheduler::TaskContainer task = context.Continue(TaskScheduler::duration_t::zero(), TaskCoroutine::Resumer(promise._frame.lock()));
+
+    // forget the waiters which were cancelled meanwhile
+    std::erase_if(_signal._waiters, [](Waiter const& waiter)
+    {
+        return waiter.Task.expired();
+    });
+
+    _signal._waiters.push_back({ task, context._owner });
+    context.Dispatch([task](TaskScheduler& scheduler) -> TaskScheduler&
+    {
+        scheduler._parked.push_back(task);
+        return scheduler;
+    });
+}
+
+void TaskSignal::Notify()
+{
+    // coroutines woken here which wait for the signal again are woken by the next notify
+    std::vector<Waiter> waiters;
+    waiters.swap(_waiters);
+
+    for (Waiter const& waiter : waiters)
+    {
+        TaskScheduler::TaskContainer const task = waiter.Task.lock();
+        if (!task)
+            continue;
+
+        if (std::shared_ptr<TaskScheduler> const owner = waiter.Owner.lock())
+            owner->WakeTask(task);
+    }
+}
+
+bool TaskSignal::HasWaiters() const
+{
+    return std::any_of(_waiters.begin(), _waiters.end(), [](Waiter const& waiter)
+    {
+        return !waiter.Task.expired();
+    });
+}
@@ -0,0 +1,203 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TASK_COROUTINE_H_
+#define _TASK_COROUTINE_H_
+
+#include "TaskScheduler.h"
+#include <coroutine>
+#include <memory>
+#include <utility>
+
+/// Return type of coroutines driven by a TaskScheduler.
+/// Scripted sequences which would be chains of nested TaskContext::Schedule calls
+/// can be written as one function instead:
+///
+///     TaskCoroutine Intro()
+///     {
+///         me->Yell(SAY_INTRO_1);
+///         co_await TaskCoroutine::Wait(5s);
+///         co_await _gateOpened;
+///         me->Yell(SAY_INTRO_2);
+///     }
+///
+///     scheduler.Start(GROUP_INTRO, Intro());
+///
+/// The coroutine starts suspended and runs from the next update of the scheduler it was started on.
+/// While it waits it is nothing but one task of that scheduler which resumes it, so a waiting
+/// coroutine costs no update time, and it is delayed and cancelled together with its group.
+/// Cancelling it or destroying its scheduler destroys the coroutine at its suspension point,
+/// the code after that co_await never runs.
+/// A coroutine which is a member function keeps `this` in its frame, the same as a task
+/// capturing `this`, so the scheduler has to be cancelled or destroyed before the object is.
+class TaskCoroutine
+{
+    friend class TaskScheduler;
+    friend class TaskSignal;
+
+    class Frame;
+    typedef std::shared_ptr<Frame> FramePtr;
+
+public:
+    class promise_type
+    {
+        friend class TaskCoroutine;
+        friend class TaskSignal;
+
+        /// The started coroutine this promise belongs to
+        std::weak_ptr<Frame> _frame;
+
+        /// The task resuming the coroutine, only set while it runs
+        TaskContext* _context = nullptr;
+
+    public:
+        TaskCoroutine get_return_object()
+        {
+            return TaskCoroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return { }; }
+        std::suspend_always final_suspend() const noexcept { return { }; }
+        void return_void() const noexcept { }
+
+        // Exceptions leave TaskScheduler::Update as they do for plain tasks
+        void unhandled_exception() const { throw; }
+    };
+
+    typedef std::coroutine_handle<promise_type> handle_t;
+
+    /// What the coroutine co_awaits to wait for a time or a condition.
+    class WaitAwaiter
+    {
+        TaskScheduler::duration_t _time;
+        std::function<bool()> _condition;
+
+    public:
+        WaitAwaiter(TaskScheduler::duration_t const& time, std::function<bool()> condition)
+            : _time(time), _condition(std::move(condition)) { }
+
+        bool await_ready() const { return _condition && _condition(); }
+        void await_suspend(handle_t handle);
+        void await_resume() const noexcept { }
+    };
+
+    TaskCoroutine(TaskCoroutine const&) = delete;
+    TaskCoroutine& operator= (TaskCoroutine const&) = delete;
+
+    TaskCoroutine(TaskCoroutine&& right) noexcept
+        : _handle(std::exchange(right._handle, nullptr)) { }
+
+    TaskCoroutine& operator= (TaskCoroutine&& right) noexcept;
+
+    /// A coroutine which was never started is destroyed with its return object
+    ~TaskCoroutine();
+
+    /// Waits the given duration.
+    /// Like TaskContext::Repeat the time counts from when the coroutine was due,
+    /// so a sequence of waits does not drift with the update rate.
+    template<class _Rep, class _Period>
+    static WaitAwaiter Wait(std::chrono::duration<_Rep, _Period> const& time)
+    {
+        return WaitAwaiter(std::chrono::duration_cast<TaskScheduler::duration_t>(time), nullptr);
+    }
+
+    /// Waits a random duration between min and max.
+    template<class _RepLeft, class _PeriodLeft, class _RepRight, class _PeriodRight>
+    static WaitAwaiter Wait(std::chrono::duration<_RepLeft, _PeriodLeft> const& min,
+                            std::chrono::duration<_RepRight, _PeriodRight> const& max)
+    {
+        return Wait(TaskScheduler::RandomDurationBetween(min, max));
+    }
+
+    /// Waits until the condition is true, it is checked when awaited and then once every interval
+    /// counted from the update that checked it last, a late update does not check it repeatedly.
+    /// Use a TaskSignal instead where the code changing the state can notify the coroutine,
+    /// that waits without checking anything.
+    template<class _Rep, class _Period>
+    static WaitAwaiter WaitUntil(std::chrono::duration<_Rep, _Period> const& interval, std::function<bool()> condition)
+    {
+        return WaitAwaiter(std::chrono::duration_cast<TaskScheduler::duration_t>(interval), std::move(condition));
+    }
+
+private:
+    explicit TaskCoroutine(handle_t handle) : _handle(handle) { }
+
+    /// Owns the frame of a started coroutine, shared by the task that resumes it next
+    class Frame
+    {
+        handle_t _handle;
+
+    public:
+        explicit Frame(handle_t handle) : _handle(handle) { }
+        ~Frame();
+
+        Frame(Frame const&) = delete;
+        Frame& operator= (Frame const&) = delete;
+
+        handle_t GetHandle() const { return _handle; }
+
+        /// Runs the coroutine from within the given task until its next co_await.
+        void Resume(TaskContext& context);
+    };
+
+    /// A task handler resuming the coroutine
+    static TaskScheduler::task_handler_t Resumer(FramePtr frame);
+
+    /// Hands the coroutine over to a task which starts it at the given time
+    TaskScheduler::TaskContainer Launch(TaskScheduler::timepoint_t const& now, std::optional<TaskScheduler::group_t> const& group);
+
+    handle_t _handle;
+};
+
+/// Something coroutines wait for with co_await until Notify wakes them.
+/// A waiting coroutine is parked in its scheduler and costs nothing until it is woken,
+/// it is resumed by the next update of its scheduler, or by the running one when notified from a task.
+/// The signal only refers to its waiters, destroying it leaves them parked until their group
+/// is cancelled or their scheduler is destroyed.
+class TaskSignal
+{
+    struct Waiter
+    {
+        std::weak_ptr<TaskScheduler::Task> Task;
+        std::weak_ptr<TaskScheduler> Owner;
+    };
+
+    std::vector<Waiter> _waiters;
+
+public:
+    class Awaiter
+    {
+        TaskSignal& _signal;
+
+    public:
+        explicit Awaiter(TaskSignal& signal) : _signal(signal) { }
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(TaskCoroutine::handle_t handle);
+        void await_resume() const noexcept { }
+    };
+
+    Awaiter operator co_await() { return Awaiter(*this); }
+
+    /// Wakes all coroutines waiting for the signal.
+    void Notify();
+
+    /// Returns true if a coroutine waits for the signal.
+    [[nodiscard]] bool HasWaiters() const;
+};
+
+#endif
@@ -16,7 +16,9 @@
  */
 
 #include "TaskScheduler.h"
+#include "TaskCoroutine.h"
 #include "Errors.h"
+#include <algorithm>
 
 TaskScheduler& TaskScheduler::ClearValidator()
 {
@@ -42,11 +44,22 @@ TaskScheduler& TaskScheduler::Async(std::function<void()> const& callable)
     return *this;
 }
 
+TaskScheduler& TaskScheduler::Start(TaskCoroutine&& coroutine)
+{
+    return InsertTask(coroutine.Launch(_now, std::nullopt));
+}
+
+TaskScheduler& TaskScheduler::Start(group_t const group, TaskCoroutine&& coroutine)
+{
+    return InsertTask(coroutine.Launch(_now, group));
+}
+
 TaskScheduler& TaskScheduler::CancelAll()
 {
     /// Clear the task holder
     _task_holder.Clear();
     _asyncHolder = AsyncHolder();
+    _parked.clear();
     return *this;
 }
 
@@ -56,6 +69,11 @@ TaskScheduler& TaskScheduler::CancelGroup(group_t const group)
     {
         return task->IsInGroup(group);
     });
+
+    std::erase_if(_parked, [group](TaskContainer const& task)
+    {
+        return task->IsInGroup(group);
+    });
     return *this;
 }
 
@@ -73,6 +91,23 @@ TaskScheduler& TaskScheduler::InsertTask(TaskContainer task)
     return *this;
 }
 
+TaskScheduler& TaskScheduler::InsertTaskAfter(TaskContainer task, duration_t const& time)
+{
+    task->_end = _now + time;
+    return InsertTask(std::move(task));
+}
+
+void TaskScheduler::WakeTask(TaskContainer const& task)
+{
+    auto const itr = std::find(_parked.begin(), _parked.end(), task);
+    if (itr == _parked.end())
+        return;
+
+    _parked.erase(itr);
+    task->_end = _now;
+    InsertTask(task);
+}
+
 void TaskScheduler::Dispatch(success_t const& callback)
 {
     // If the validation failed abort the dispatching here.
@@ -121,7 +156,13 @@ void TaskScheduler::Dispatch(success_t const& callback)
 
 bool TaskScheduler::IsGroupScheduled(group_t const group)
 {
-    return _task_holder.IsGroupQueued(group);
+    if (_task_holder.IsGroupQueued(group))
+        return true;
+
+    return std::any_of(_parked.begin(), _parked.end(), [group](TaskContainer const& task)
+    {
+        return task->IsInGroup(group);
+    });
 }
 
 Milliseconds TaskScheduler::GetNextGroupOccurrence(group_t const group) const
@@ -131,81 +172,68 @@ Milliseconds TaskScheduler::GetNextGroupOccurrence(group_t const group) const
 
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.insert(task);
+    timepoint_t const end = task->_end;
+    container.Push(end, std::move(task));
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
-    return result;
+    return container.Pop();
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.Top().value;
 }
 
 void TaskScheduler::TaskQueue::Clear()
 {
-    container.clear();
+    container.Clear();
 }
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
+    container.RemoveIf([&filter](TaskNode const& node)
+    {
+        return filter(node.value);
+    });
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
+    // the filter changes the end of the tasks it accepts, they are queued again at their new end
+    std::vector<TaskNode> cache;
+    container.ExtractIf([&filter](TaskNode const& node)
+    {
+        return filter(node.value);
+    }, cache);
 
-    container.insert(cache.begin(), cache.end());
+    for (TaskNode& node : cache)
+        Push(std::move(node.value));
 }
 
 bool TaskScheduler::TaskQueue::IsGroupQueued(group_t const group)
 {
-    for (auto const& task : container)
+    return container.FindFirst([group](TaskNode const& node)
     {
-        if (task->IsInGroup(group))
-        {
-            return true;
-        }
-    }
-
-    return false;
+        return node.value->IsInGroup(group);
+    }) != nullptr;
 }
 
 TaskScheduler::timepoint_t TaskScheduler::TaskQueue::GetNextGroupOccurrence(group_t const group) const
 {
     TaskScheduler::timepoint_t next = TaskScheduler::timepoint_t::max();
-    for (auto const& task : container)
-        if (task->IsInGroup(group) && task->_end < next)
-            next = task->_end;
+    container.ForEach([group, &next](TaskNode const& node)
+    {
+        if (node.value->IsInGroup(group) && node.value->_end < next)
+            next = node.value->_end;
+    });
     return next;
 }
 
 bool TaskScheduler::TaskQueue::IsEmpty() const
 {
-    return container.empty();
+    return container.IsEmpty();
 }
 
 TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
@@ -281,3 +309,8 @@ void TaskContext::Invoke()
 {
     _task->_task(*this);
 }
+
+TaskScheduler::TaskContainer TaskContext::Continue(TaskScheduler::duration_t const& time, TaskScheduler::task_handler_t const& task) const
+{
+    return TaskScheduler::TaskContainer(new TaskScheduler::Task(_task->_end + time, time, _task->_group, 0, task));
+}
@@ -18,6 +18,7 @@
 #ifndef _TASK_SCHEDULER_H_
 #define _TASK_SCHEDULER_H_
 
+#include "TimerQueue.h"
 #include "Util.h"
 #include <chrono>
 #include <functional>
@@ -27,6 +28,8 @@
 #include <vector>
 
 class TaskContext;
+class TaskCoroutine;
+class TaskSignal;
 
 /// The TaskScheduler class provides the ability to schedule std::function's in the near future.
 /// Use TaskScheduler::Update to update the scheduler.
@@ -41,9 +44,12 @@ class TaskContext;
 /// with the same duration or a new one.
 /// It also provides access to the repeat counter which is useful for task that repeat itself often
 /// but behave different every time (spoken event dialogs for example).
+/// Sequences which would be chains of nested tasks can be written as a TaskCoroutine instead (see TaskCoroutine.h).
 class TaskScheduler
 {
     friend class TaskContext;
+    friend class TaskCoroutine;
+    friend class TaskSignal;
 
     // Time definitions (use steady clock)
     typedef std::chrono::steady_clock clock_t;
@@ -118,17 +124,12 @@ class TaskScheduler
     typedef std::shared_ptr<Task> TaskContainer;
 
     /// Container which provides Task order, insert and reschedule operations.
-    struct Compare
-    {
-        bool operator() (TaskContainer const& left, TaskContainer const& right) const
-        {
-            return (*left.get()) < (*right.get());
-        };
-    };
-
     class TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        typedef TimerQueue<timepoint_t, TaskContainer> Container;
+        typedef Container::Node TaskNode;
+
+        Container container;
 
     public:
         // Pushes the task in the container
@@ -169,6 +170,10 @@ class TaskScheduler
     /// the next update tick.
     AsyncHolder _asyncHolder;
 
+    /// Tasks of coroutines waiting for a TaskSignal, they are not due
+    /// before the signal wakes them and are only cancelled with their group.
+    std::vector<TaskContainer> _parked;
+
     predicate_t _predicate;
 
     static bool EmptyValidator()
@@ -226,6 +231,14 @@ public:
     /// Its safe to modify the TaskScheduler from within the callable.
     TaskScheduler& Async(std::function<void()> const& callable);
 
+    /// Starts a coroutine which runs from the next update tick on.
+    /// Its waits are tasks of this scheduler (see TaskCoroutine).
+    TaskScheduler& Start(TaskCoroutine&& coroutine);
+
+    /// Starts a coroutine in the given group which runs from the next update tick on.
+    /// Its waits are tasks of the group, cancelling the group destroys the coroutine.
+    TaskScheduler& Start(group_t const group, TaskCoroutine&& coroutine);
+
     /// Schedule an event with a fixed rate.
     /// Never call this from within a task context! Use TaskContext::Schedule instead!
     template<class _Rep, class _Period>
@@ -383,6 +396,12 @@ private:
     /// Insert a new task to the enqueued tasks.
     TaskScheduler& InsertTask(TaskContainer task);
 
+    /// Insert a task due the given time after the current update time.
+    TaskScheduler& InsertTaskAfter(TaskContainer task, duration_t const& time);
+
+    /// Moves a parked task to the enqueued tasks, due now.
+    void WakeTask(TaskContainer const& task);
+
     template<class _Rep, class _Period>
     TaskScheduler& ScheduleAt(timepoint_t const& end,
                               std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
@@ -420,6 +439,8 @@ private:
 class TaskContext
 {
     friend class TaskScheduler;
+    friend class TaskCoroutine;
+    friend class TaskSignal;
 
     /// Associated task
     TaskScheduler::TaskContainer _task;
@@ -656,6 +677,9 @@ private:
 
     /// Invokes the associated hook of the task.
     void Invoke();
+
+    /// Creates a task continuing this one after the given time, in the same group.
+    TaskScheduler::TaskContainer Continue(TaskScheduler::duration_t const& time, TaskScheduler::task_handler_t const& task) const;
 };
 
 #endif
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TIMER_QUEUE_H_
+#define _TIMER_QUEUE_H_
+
+#include "Define.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/// Queue of values ordered by the time they are due, backing EventProcessor, EventMap and TaskScheduler.
+/// The values live in a 4-ary heap inside one vector, so scheduling does not allocate once the
+/// vector has grown to the working size of its owner.
+/// Values due at the same time leave the queue in the order they were pushed, the same order
+/// a std::multimap keyed by the time gives.
+template<class Time, class Value>
+class TimerQueue
+{
+public:
+    struct Node
+    {
+        Time time;
+        uint64 sequence;
+        Value value;
+
+        bool operator<(Node const& other) const
+        {
+            return time < other.time || (!(other.time < time) && sequence < other.sequence);
+        }
+    };
+
+    [[nodiscard]] bool IsEmpty() const { return _heap.empty(); }
+    [[nodiscard]] std::size_t Size() const { return _heap.size(); }
+
+    void Clear() { _heap.clear(); }
+
+    /// Queues a value behind all values due at the same time.
+    void Push(Time time, Value value)
+    {
+        _heap.push_back(Node{ time, _nextSequence++, std::move(value) });
+        SiftUp(_heap.size() - 1);
+    }
+
+    /// Queues a node taken out of this queue again, keeping its place among values due at the same time.
+    void Reinsert(Node node)
+    {
+        _heap.push_back(std::move(node));
+        SiftUp(_heap.size() - 1);
+    }
+
+    /// The value due first.
+    [[nodiscard]] Node const& Top() const { return _heap.front(); }
+
+    /// Removes the value due first and returns it.
+    Value Pop()
+    {
+        Value value = std::move(_heap.front().value);
+        RemoveAt(0);
+        return value;
+    }
+
+    /// The first value in queue order the predicate accepts, nullptr if there is none.
+    template<class Predicate>
+    [[nodiscard]] Node const* FindFirst(Predicate&& predicate) const
+    {
+        Node const* first = nullptr;
+        for (Node const& node : _heap)
+            if (predicate(node) && (!first || node < *first))
+                first = &node;
+
+        return first;
+    }
+
+    /// Removes every value the predicate accepts, the removed nodes are appended to out in queue order.
+    template<class Predicate>
+    void ExtractIf(Predicate&& predicate, std::vector<Node>& out)
+    {
+        std::size_t const first = out.size();
+        auto kept = std::partition(_heap.begin(), _heap.end(), [&predicate](Node const& node) { return !predicate(node); });
+        if (kept == _heap.end())
+            return;
+
+        std::move(kept, _heap.end(), std::back_inserter(out));
+        _heap.erase(kept, _heap.end());
+        std::sort(out.begin() + first, out.end());
+        Heapify();
+    }
+
+    /// Removes every value the predicate accepts.
+    template<class Predicate>
+    std::size_t RemoveIf(Predicate&& predicate)
+    {
+        auto kept = std::remove_if(_heap.begin(), _heap.end(), predicate);
+        std::size_t const removed = std::distance(kept, _heap.end());
+        if (!removed)
+            return 0;
+
+        _heap.erase(kept, _heap.end());
+        Heapify();
+        return removed;
+    }
+
+    /// Visits every queued node in no particular order, the queue must not be changed meanwhile.
+    template<class Function>
+    void ForEach(Function&& function) const
+    {
+        for (Node const& node : _heap)
+            function(node);
+    }
+
+    /// Takes all nodes out of the queue in queue order, the sequence continues for later pushes.
+    void TakeAll(std::vector<Node>& out)
+    {
+        std::size_t const first = out.size();
+        std::move(_heap.begin(), _heap.end(), std::back_inserter(out));
+        _heap.clear();
+        std::sort(out.begin() + first, out.end());
+    }
+
+private:
+    static constexpr std::size_t ARITY = 4;
+
+    void SiftUp(std::size_t index)
+    {
+        Node node = std::move(_heap[index]);
+        while (index > 0)
+        {
+            std::size_t parent = (index - 1) / ARITY;
+            if (!(node < _heap[parent]))
+                break;
+
+            _heap[index] = std::move(_heap[parent]);
+            index = parent;
+        }
+
+        _heap[index] = std::move(node);
+    }
+
+    void SiftDown(std::size_t index)
+    {
+        std::size_t const count = _heap.size();
+        Node node = std::move(_heap[index]);
+        while (true)
+        {
+            std::size_t child = index * ARITY + 1;
+            if (child >= count)
+                break;
+
+            std::size_t best = child;
+            std::size_t const last = std::min(child + ARITY, count);
+            for (++child; child < last; ++child)
+                if (_heap[child] < _heap[best])
+                    best = child;
+
+            if (!(_heap[best] < node))
+                break;
+
+            _heap[index] = std::move(_heap[best]);
+            index = best;
+        }
+
+        _heap[index] = std::move(node);
+    }
+
+    void RemoveAt(std::size_t index)
+    {
+        std::size_t const last = _heap.size() - 1;
+        if (index != last)
+        {
+            _heap[index] = std::move(_heap[last]);
+            _heap.pop_back();
+            if (index > 0 && _heap[index] < _heap[(index - 1) / ARITY])
+                SiftUp(index);
+            else
+                SiftDown(index);
+        }
+        else
+            _heap.pop_back();
+    }
+
+    void Heapify()
+    {
+        if (_heap.size() < 2)
+            return;
+
+        for (std::size_t index = (_heap.size() - 2) / ARITY + 1; index-- > 0;)
+            SiftDown(index);
+    }
+
+    std::vector<Node> _heap;
+    uint64 _nextSequence{ 0 };
+};
+
+#endif
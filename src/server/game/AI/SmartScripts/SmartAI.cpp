@@ -103,20 +103,16 @@ void SmartAI::UpdateDespawn(const uint32 diff)
         mDespawnTime -= diff;
 }
 
-WayPoint* SmartAI::GetNextWayPoint()
+WayPoint const* SmartAI::GetNextWayPoint()
 {
     if (!mWayPoints || mWayPoints->empty())
         return nullptr;
 
     mCurrentWPID++;
-    WPPath::const_iterator itr = mWayPoints->find(mCurrentWPID);
-    if (itr != mWayPoints->end())
+    if (WayPoint const* wp = mWayPoints->GetPoint(mCurrentWPID))
     {
-        mLastWP = (*itr).second;
-        if (mLastWP->id != mCurrentWPID)
-            LOG_ERROR("scripts.ai.sai", "SmartAI::GetNextWayPoint: Got not expected waypoint id {}, expected {}", mLastWP->id, mCurrentWPID);
-
-        return (*itr).second;
+        mLastWP = wp;
+        return wp;
     }
     return nullptr;
 }
@@ -133,12 +129,8 @@ void SmartAI::GenerateWayPointArray(Movement::PointsArray* points)
         points->clear();
         points->push_back(G3D::Vector3(me->GetPositionX(), me->GetPositionY(), me->GetPositionZ()));
         uint32 wpCounter = mCurrentWPID;
-        WPPath::const_iterator itr;
-        while ((itr = mWayPoints->find(wpCounter++)) != mWayPoints->end())
-        {
-            WayPoint* wp = (*itr).second;
+        while (WayPoint const* wp = mWayPoints->GetPoint(wpCounter++))
             points->push_back(G3D::Vector3(wp->x, wp->y, wp->z));
-        }
     }
     else
     {
@@ -151,12 +143,9 @@ void SmartAI::GenerateWayPointArray(Movement::PointsArray* points)
 
             uint32 cnt = 0;
             uint32 wpCounter = mCurrentWPID;
-            WPPath::const_iterator itr;
-            while ((itr = mWayPoints->find(wpCounter++)) != mWayPoints->end() && cnt++ <= length)
-            {
-                WayPoint* wp = (*itr).second;
+            WayPoint const* wp;
+            while ((wp = mWayPoints->GetPoint(wpCounter++)) && cnt++ <= length)
                 pVector.push_back(G3D::Vector3(wp->x, wp->y, wp->z));
-            }
 
             if (pVector.size() > 2) // more than source + dest
             {
@@ -198,7 +187,7 @@ void SmartAI::StartPath(bool run, uint32 path, bool repeat, Unit* invoker)
     if (!mWayPoints || mWayPoints->empty())
         return;
 
-    if (WayPoint* wp = GetNextWayPoint())
+    if (WayPoint const* wp = GetNextWayPoint())
     {
         AddEscortState(SMART_ESCORT_ESCORTING);
         mCanRepeatPath = repeat;
@@ -257,10 +246,10 @@ void SmartAI::PausePath(uint32 delay, bool forced)
         me->StopMoving();
         me->GetMotionMaster()->MoveIdle();//force stop
 
-        auto waypoint = mWayPoints->find(mCurrentWPID);
-        if (waypoint->second->o.has_value())
+        WayPoint const* waypoint = mWayPoints->GetPoint(mCurrentWPID);
+        if (waypoint && waypoint->o.has_value())
         {
-            me->SetFacingTo(waypoint->second->o.has_value());
+            me->SetFacingTo(*waypoint->o);
         }
     }
     GetScript()->ProcessEventsFor(SMART_EVENT_WAYPOINT_PAUSED, nullptr, mCurrentWPID, GetScript()->GetPathId());
@@ -56,7 +56,7 @@ public:
     void StopPath(uint32 DespawnTime = 0, uint32 quest = 0, bool fail = false);
     void EndPath(bool fail = false);
     void ResumePath();
-    WayPoint* GetNextWayPoint();
+    WayPoint const* GetNextWayPoint();
     void GenerateWayPointArray(Movement::PointsArray* points);
     bool HasEscortState(uint32 uiEscortState) { return (mEscortState & uiEscortState); }
     void AddEscortState(uint32 uiEscortState) { mEscortState |= uiEscortState; }
@@ -226,13 +226,13 @@ private:
     void ReturnToLastOOCPos();
     void UpdatePath(const uint32 diff);
     SmartScript mScript;
-    WPPath* mWayPoints;
+    WPPath const* mWayPoints;
     uint32 mEscortState;
     uint32 mCurrentWPID;
     bool mWPReached;
     bool mOOCReached;
     uint32 mWPPauseTimer;
-    WayPoint* mLastWP;
+    WayPoint const* mLastWP;
     uint32 mEscortNPCFlags;
     uint32 GetWPCount() { return mWayPoints ? mWayPoints->size() : 0; }
     bool mCanRepeatPath;
@@ -134,27 +134,30 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    // most objects have no handler for most of the events they receive
+    if (e >= SMART_EVENT_AC_END || !mEventTypes.test(e))
+        return;
+
+    auto begin = std::lower_bound(mEventIndex.begin(), mEventIndex.end(), uint32(e), [this](uint32 index, uint32 type)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        return mEvents[index].GetEventType() < type;
+    });
 
-        if (eventType == e)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+    for (auto itr = begin; itr != mEventIndex.end() && mEvents[*itr].GetEventType() == uint32(e); ++itr)
+    {
+        SmartScriptHolder& holder = mEvents[*itr];
+        ConditionList conds = sConditionMgr->GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type);
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+        if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+        {
+            ASSERT(executionStack.empty());
+            executionStack.emplace_back(SmartScriptFrame{ holder, unit, var0, var1, bvar, spell, gob });
+            while (!executionStack.empty())
             {
-                ASSERT(executionStack.empty());
-                executionStack.emplace_back(SmartScriptFrame{ *i, unit, var0, var1, bvar, spell, gob });
-                while (!executionStack.empty())
-                {
-                    auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
-                    executionStack.pop_back();
-                    ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
-                }
+                auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
+                executionStack.pop_back();
+                ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
             }
         }
     }
@@ -2517,21 +2520,17 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     {
                         for (uint32 wp = e.action.startClosestWaypoint.pathId1; wp <= e.action.startClosestWaypoint.pathId2; ++wp)
                         {
-                            WPPath* path = sSmartWaypointMgr->GetPath(wp);
+                            WPPath const* path = sSmartWaypointMgr->GetPath(wp);
                             if (!path || path->empty())
                                 continue;
 
-                            auto itrWp = path->find(1);
-                            if (itrWp != path->end())
+                            if (WayPoint const* wpData = path->GetPoint(1))
                             {
-                                if (WayPoint* wpData = itrWp->second)
+                                float distToThisPath = creature->GetExactDistSq(wpData->x, wpData->y, wpData->z);
+                                if (distToThisPath < distanceToClosest)
                                 {
-                                    float distToThisPath = creature->GetExactDistSq(wpData->x, wpData->y, wpData->z);
-                                    if (distToThisPath < distanceToClosest)
-                                    {
-                                        distanceToClosest = distToThisPath;
-                                        closestWpId = wp;
-                                    }
+                                    distanceToClosest = distToThisPath;
+                                    closestWpId = wp;
                                 }
                             }
                         }
@@ -4980,6 +4979,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
@@ -4993,6 +4993,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     if (mEventSortingRequired)
     {
         SortEvents(mEvents);
+        BuildEventIndex();
         mEventSortingRequired = false;
     }
 
@@ -5056,6 +5057,29 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::BuildEventIndex()
+{
+    mEventIndex.clear();
+    mEventTypes.reset();
+    mEventIndex.reserve(mEvents.size());
+
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        uint32 eventType = mEvents[i].GetEventType();
+        // links are only processed through the event they are linked from
+        if (eventType == SMART_EVENT_LINK || eventType >= SMART_EVENT_AC_END)
+            continue;
+
+        mEventIndex.push_back(i);
+        mEventTypes.set(eventType);
+    }
+
+    std::stable_sort(mEventIndex.begin(), mEventIndex.end(), [this](uint32 left, uint32 right)
+    {
+        return mEvents[left].GetEventType() < mEvents[right].GetEventType();
+    });
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1200;
@@ -5078,7 +5102,7 @@ void SmartScript::RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll)
     e.runOnce = false;
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTrigger const* at)
 {
     (void)at; // ensure that the variable is referenced even if extra logs are disabled in order to pass compiler checks
 
@@ -5091,7 +5115,9 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
             LOG_DEBUG("sql.sql", "SmartScript: EventMap for AreaTrigger {} is empty but is using SmartScript.", at->entry);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+
+    mEvents.reserve(mEvents.size() + e.size());
+    for (SmartAIEventList::const_iterator i = e.begin(); i != e.end(); ++i)
     {
 #ifndef ACORE_DEBUG
         if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
@@ -5115,36 +5141,36 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
 
-        FillScript(e, me, nullptr);
+        FillScript(*e, me, nullptr);
 
         if (CreatureTemplate const* cInfo = me->GetCreatureTemplate())
         {
             if (cInfo->HasFlagsExtra(CREATURE_FLAG_EXTRA_DONT_OVERRIDE_ENTRY_SAI))
             {
-                e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-                FillScript(e, me, nullptr);
+                e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+                FillScript(*e, me, nullptr);
             }
         }
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, nullptr);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(*e, go, nullptr);
     }
     else if (trigger)
     {
-        e = sSmartScriptMgr->GetScript((int32)trigger->entry, mScriptType);
-        FillScript(e, nullptr, trigger);
+        FillScript(sSmartScriptMgr->GetScript((int32)trigger->entry, mScriptType), nullptr, trigger);
     }
+
+    BuildEventIndex();
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTrigger const* at)
@@ -23,6 +23,7 @@
 #include "SmartScriptMgr.h"
 #include "Spell.h"
 #include "Unit.h"
+#include <bitset>
 #include <deque>
 
 class SmartScript
@@ -44,7 +45,7 @@ public:
 
     void OnInitialize(WorldObject* obj, AreaTrigger const* at = nullptr);
     void GetScript();
-    void FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at);
+    void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTrigger const* at);
 
     void ProcessEventsFor(SMART_EVENT e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void ProcessEvent(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
@@ -214,10 +215,15 @@ private:
     bool IsInPhase(uint32 p) const;
 
     void SortEvents(SmartAIEventList& events);
+    void BuildEventIndex();
     void RaisePriority(SmartScriptHolder& e);
     void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
     SmartAIEventList mEvents;
+    // positions in mEvents grouped by event type, in the order of mEvents within one type
+    // rebuilt whenever mEvents is filled, extended or sorted
+    std::vector<uint32> mEventIndex;
+    std::bitset<SMART_EVENT_AC_END> mEventTypes;
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
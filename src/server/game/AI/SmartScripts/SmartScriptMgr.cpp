@@ -26,6 +26,7 @@
 #include "ObjectMgr.h"
 #include "ScriptedCreature.h"
 #include "SpellMgr.h"
+#include <tuple>
 
 bool SmartAIMgr::IsSAIBoolValid(SmartScriptHolder const& e, SAIBool value)
 {
@@ -48,15 +49,8 @@ void SmartWaypointMgr::LoadFromDB()
 {
     uint32 oldMSTime = getMSTime();
 
-    for (std::unordered_map<uint32, WPPath*>::iterator itr = waypoint_map.begin(); itr != waypoint_map.end(); ++itr)
-    {
-        for (WPPath::iterator pathItr = itr->second->begin(); pathItr != itr->second->end(); ++pathItr)
-            delete pathItr->second;
-
-        delete itr->second;
-    }
-
     waypoint_map.clear();
+    waypoints.clear();
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMARTAI_WP);
     PreparedQueryResult result = WorldDatabase.Query(stmt);
@@ -68,6 +62,9 @@ void SmartWaypointMgr::LoadFromDB()
         return;
     }
 
+    // the paths point into the arena once it is complete: entry, first point, point count
+    std::vector<std::tuple<uint32, uint32, uint32>> ranges;
+
     uint32 count = 0;
     uint32 total = 0;
     uint32 last_entry = 0;
@@ -86,9 +83,9 @@ void SmartWaypointMgr::LoadFromDB()
             o = fields[5].Get<float>();
         uint32 delay = fields[6].Get<uint32>();
 
-        if (last_entry != entry)
+        if (ranges.empty() || last_entry != entry)
         {
-            waypoint_map[entry] = new WPPath();
+            ranges.emplace_back(entry, uint32(waypoints.size()), 0);
             last_id = 1;
             count++;
         }
@@ -97,25 +94,29 @@ void SmartWaypointMgr::LoadFromDB()
             LOG_ERROR("sql.sql", "SmartWaypointMgr::LoadFromDB: Path entry {}, unexpected point id {}, expected {}.", entry, id, last_id);
 
         last_id++;
-        (*waypoint_map[entry])[id] = new WayPoint(id, x, y, z, o, delay);
+
+        // a repeated point id replaces the previous point
+        uint32& points = std::get<2>(ranges.back());
+        if (points && waypoints.back().id == id)
+            waypoints.back() = WayPoint(id, x, y, z, o, delay);
+        else
+        {
+            waypoints.emplace_back(id, x, y, z, o, delay);
+            ++points;
+        }
 
         last_entry = entry;
         total++;
     } while (result->NextRow());
 
-    LOG_INFO("server.loading", ">> Loaded {} SmartAI waypoint paths (total {} waypoints) in {} ms", count, total, GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
-}
+    waypoints.shrink_to_fit();
 
-SmartWaypointMgr::~SmartWaypointMgr()
-{
-    for (std::unordered_map<uint32, WPPath*>::iterator itr = waypoint_map.begin(); itr != waypoint_map.end(); ++itr)
-    {
-        for (WPPath::iterator pathItr = itr->second->begin(); pathItr != itr->second->end(); ++pathItr)
-            delete pathItr->second;
+    waypoint_map.reserve(ranges.size());
+    for (auto const& [entry, first, points] : ranges)
+        waypoint_map.emplace(entry, WPPath(waypoints.data() + first, points));
 
-        delete itr->second;
-    }
+    LOG_INFO("server.loading", ">> Loaded {} SmartAI waypoint paths (total {} waypoints) in {} ms", count, total, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
 }
 
 SmartAIMgr* SmartAIMgr::instance()
@@ -25,6 +25,7 @@
 #include "ObjectMgr.h"
 #include "Optional.h"
 #include "SpellMgr.h"
+#include <algorithm>
 #include <limits>
 
 typedef uint32 SAIBool;
@@ -1999,7 +2000,33 @@ public:
     static constexpr uint32 DEFAULT_PRIORITY = std::numeric_limits<uint32>::max();
 };
 
-typedef std::unordered_map<uint32, WayPoint*> WPPath;
+// The points of one path of the `waypoints` table sorted by id, a range of the arena of SmartWaypointMgr
+class WPPath
+{
+public:
+    WPPath(WayPoint const* points, uint32 count) : _points(points), _count(count) { }
+
+    [[nodiscard]] std::size_t size() const { return _count; }
+    [[nodiscard]] bool empty() const { return !_count; }
+
+    [[nodiscard]] WayPoint const* begin() const { return _points; }
+    [[nodiscard]] WayPoint const* end() const { return _points + _count; }
+
+    // Returns the point with the given id, nullptr if the path has none
+    [[nodiscard]] WayPoint const* GetPoint(uint32 id) const
+    {
+        // the ids of a path are expected to count up from 1
+        if (id && id <= _count && _points[id - 1].id == id)
+            return &_points[id - 1];
+
+        WayPoint const* point = std::lower_bound(begin(), end(), id, [](WayPoint const& left, uint32 right) { return left.id < right; });
+        return point != end() && point->id == id ? point : nullptr;
+    }
+
+private:
+    WayPoint const* _points;
+    uint32 _count;
+};
 
 typedef std::vector<WorldObject*> ObjectVector;
 
@@ -2042,21 +2069,24 @@ class SmartWaypointMgr
 {
     SmartWaypointMgr() {}
 public:
-    ~SmartWaypointMgr();
+    ~SmartWaypointMgr() {}
 
     static SmartWaypointMgr* instance();
 
     void LoadFromDB();
 
-    WPPath* GetPath(uint32 id)
+    WPPath const* GetPath(uint32 id) const
     {
-        if (waypoint_map.find(id) != waypoint_map.end())
-            return waypoint_map[id];
-        else return 0;
+        auto itr = waypoint_map.find(id);
+        if (itr != waypoint_map.end())
+            return &itr->second;
+
+        return nullptr;
     }
 
 private:
-    std::unordered_map<uint32, WPPath*> waypoint_map;
+    std::vector<WayPoint> waypoints;                   // the points of all paths, path after path
+    std::unordered_map<uint32, WPPath> waypoint_map;   // the ranges of waypoints by path entry
 };
 
 // all events for a single entry
@@ -2077,17 +2107,18 @@ public:
     void LoadSmartAIFromDB();
     void CheckIfSmartAIInDatabaseExists();
 
-    SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+    // the loaded script is shared by every object using it, each SmartScript copies it once
+    SmartAIEventList const& GetScript(int32 entry, SmartScriptType type) const
     {
-        SmartAIEventList temp;
-        if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-            return mEventMap[uint32(type)][entry];
-        else
-        {
-            if (entry > 0) //first search is for guid (negative), do not drop error if not found
-                LOG_DEBUG("sql.sql", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
-            return temp;
-        }
+        static SmartAIEventList const emptyScript;
+
+        SmartAIEventMap::const_iterator itr = mEventMap[uint32(type)].find(entry);
+        if (itr != mEventMap[uint32(type)].end())
+            return itr->second;
+
+        if (entry > 0) //first search is for guid (negative), do not drop error if not found
+            LOG_DEBUG("sql.sql", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
+        return emptyScript;
     }
 
 private:
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CombatLogDispatcher.h"
+#include "CellImpl.h"
+#include "GameTime.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Map.h"
+#include "ObjectAccessor.h"
+#include "Pet.h"
+#include "Player.h"
+#include "World.h"
+#include <algorithm>
+
+// the observer budget is counted per second of game time
+static constexpr uint32 OBSERVER_BUDGET_WINDOW = 1 * IN_MILLISECONDS;
+
+void CombatLogDispatcher::Queue(Unit const* source, ObjectGuid const& attackerGUID, ObjectGuid const& victimGUID, WorldPacket&& packet)
+{
+    _entries.emplace_back(source->GetGUID(), attackerGUID, GetCharmerOrOwnerGUID(source, attackerGUID),
+        victimGUID, GetCharmerOrOwnerGUID(source, victimGUID), std::move(packet));
+}
+
+ObjectGuid CombatLogDispatcher::GetCharmerOrOwnerGUID(Unit const* source, ObjectGuid const& guid)
+{
+    // one of the two is the source itself most of the time
+    if (guid == source->GetGUID())
+        return source->GetCharmerOrOwnerGUID();
+
+    if (!guid)
+        return ObjectGuid::Empty;
+
+    if (Unit const* unit = ObjectAccessor::GetUnit(*source, guid))
+        return unit->GetCharmerOrOwnerGUID();
+
+    return ObjectGuid::Empty;
+}
+
+void CombatLogObserverBudget::Update(uint32 now)
+{
+    if (now - _windowStart < OBSERVER_BUDGET_WINDOW)
+        return;
+
+    _bytes.clear();
+    _windowStart = now;
+}
+
+bool CombatLogObserverBudget::Consume(ObjectGuid const& receiverGUID, CombatLogEntry const& entry, uint32 budget)
+{
+    // the logs of a player's own pets, totems, guardians and vehicles are not bystander traffic
+    if (!budget || entry.Involves(receiverGUID))
+        return true;
+
+    // the world packet header is sent as well
+    uint32 size = uint32(entry.Packet.size()) + 4;
+    uint32& used = _bytes[receiverGUID];
+    if (used + size > budget)
+        return false;
+
+    used += size;
+    return true;
+}
+
+void CombatLogDispatcher::Flush(Map* map)
+{
+    if (_entries.empty())
+        return;
+
+    uint32 budget = sWorld->getIntConfig(CONFIG_COMBAT_LOG_OBSERVER_BYTES_PER_SECOND);
+    _observerBudget.Update(uint32(GameTime::GetGameTimeMS().count()));
+
+    // group the entries by source, the logs of one source keep their order
+    std::stable_sort(_entries.begin(), _entries.end(), [](CombatLogEntry const& left, CombatLogEntry const& right)
+    {
+        return left.SourceGUID < right.SourceGUID;
+    });
+
+    for (auto sourceItr = _entries.begin(); sourceItr != _entries.end();)
+    {
+        auto sourceEnd = std::find_if(sourceItr, _entries.end(), [guid = sourceItr->SourceGUID](CombatLogEntry const& entry)
+        {
+            return entry.SourceGUID != guid;
+        });
+
+        Unit* source = nullptr;
+        if (sourceItr->SourceGUID.IsPlayer())
+            source = ObjectAccessor::GetPlayer(map, sourceItr->SourceGUID);
+        else if (sourceItr->SourceGUID.IsPet())
+            source = map->GetPet(sourceItr->SourceGUID);
+        else
+            source = map->GetCreature(sourceItr->SourceGUID);
+
+        // the source left the map during this update, nobody sees it anymore
+        if (!source || !source->IsInWorld())
+        {
+            sourceItr = sourceEnd;
+            continue;
+        }
+
+        if (Player* player = source->ToPlayer())
+            for (auto itr = sourceItr; itr != sourceEnd; ++itr)
+                player->SendDirectMessage(&itr->Packet);
+
+        _receivers.clear();
+        float range = source->GetVisibilityRange();
+        Acore::MessageDistDeliverer collector(source, _receivers, range);
+        Cell::VisitWorldObjects(source, collector, range);
+
+        // a player sharing the vision of a nearby unit can be found twice
+        std::sort(_receivers.begin(), _receivers.end());
+        _receivers.erase(std::unique(_receivers.begin(), _receivers.end()), _receivers.end());
+
+        for (Player* receiver : _receivers)
+            for (auto itr = sourceItr; itr != sourceEnd; ++itr)
+                if (_observerBudget.Consume(receiver->GetGUID(), *itr, budget))
+                    receiver->SendDirectMessage(&itr->Packet);
+
+        sourceItr = sourceEnd;
+    }
+
+    _entries.clear();
+    _receivers.clear();
+}
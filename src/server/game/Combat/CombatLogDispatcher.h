@@ -0,0 +1,95 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_COMBAT_LOG_DISPATCHER_H
+#define ACORE_COMBAT_LOG_DISPATCHER_H
+
+#include "ObjectGuid.h"
+#include "WorldPacket.h"
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Player;
+class Unit;
+
+// 排队中的一条战斗日志
+struct CombatLogEntry
+{
+    CombatLogEntry(ObjectGuid const& sourceGUID, ObjectGuid const& attackerGUID, ObjectGuid const& attackerOwnerGUID,
+        ObjectGuid const& victimGUID, ObjectGuid const& victimOwnerGUID, WorldPacket&& packet)
+        : SourceGUID(sourceGUID), AttackerGUID(attackerGUID), AttackerOwnerGUID(attackerOwnerGUID),
+        VictimGUID(victimGUID), VictimOwnerGUID(victimOwnerGUID), Packet(std::move(packet)) { }
+
+    // 攻击方、受害方或控制它们的单位（宠物、图腾、守护者的主人，载具和被魅惑单位的控制者）
+    [[nodiscard]] bool Involves(ObjectGuid const& guid) const
+    {
+        return guid == AttackerGUID || guid == VictimGUID ||
+            (AttackerOwnerGUID && guid == AttackerOwnerGUID) || (VictimOwnerGUID && guid == VictimOwnerGUID);
+    }
+
+    ObjectGuid SourceGUID;                      // 广播中心，即原来调用 SendMessageToSet 的单位
+    ObjectGuid AttackerGUID;
+    ObjectGuid AttackerOwnerGUID;               // 攻击方的控制者或主人
+    ObjectGuid VictimGUID;
+    ObjectGuid VictimOwnerGUID;                 // 受害方的控制者或主人
+    WorldPacket Packet;
+};
+
+// 旁观者的战斗日志字节预算，每个观察者在一秒游戏时间的窗口内最多收到 budget 字节的旁观日志
+class CombatLogObserverBudget
+{
+public:
+    CombatLogObserverBudget() : _windowStart(0) { }
+
+    // 距离当前窗口开始已过一秒时开始新的窗口，now 为游戏时间毫秒数
+    void Update(uint32 now);
+
+    // 预算允许时返回 true 并记账，与日志相关的观察者（攻击方、受害方或它们的主人）总是返回 true，budget 为 0 表示不限流
+    bool Consume(ObjectGuid const& receiverGUID, CombatLogEntry const& entry, uint32 budget);
+
+private:
+    std::unordered_map<ObjectGuid, uint32> _bytes;  // 本时间窗口内每个观察者已收到的旁观日志字节数
+    uint32 _windowStart;
+};
+
+// 地图级的战斗日志分发
+// 法术伤害、近战挥击和周期性光环的战斗日志在本次地图更新中排队，单位更新结束后统一发送：
+// 每个广播中心只查找一次周围的观察者，每个观察者按顺序收到它看得到的全部日志。
+// 观察者不是攻击方、受害方或它们的主人的日志按每秒字节数限流，超出的部分直接丢弃
+class CombatLogDispatcher
+{
+public:
+
+    // 排队一条战斗日志，source 必须在地图中
+    void Queue(Unit const* source, ObjectGuid const& attackerGUID, ObjectGuid const& victimGUID, WorldPacket&& packet);
+
+    // 发送所有排队的日志，在地图线程上调用
+    void Flush(Map* map);
+
+    [[nodiscard]] bool IsEmpty() const { return _entries.empty(); }
+
+private:
+    // 返回 guid 对应单位的控制者或主人，单位不在 source 的地图中时返回空
+    static ObjectGuid GetCharmerOrOwnerGUID(Unit const* source, ObjectGuid const& guid);
+
+    std::vector<CombatLogEntry> _entries;
+    std::vector<Player*> _receivers;            // 复用的单个广播中心的观察者列表
+    CombatLogObserverBudget _observerBudget;
+};
+
+#endif
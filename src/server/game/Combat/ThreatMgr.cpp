@@ -97,6 +97,7 @@ HostileReference::HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float th
     link(refUnit, threatMgr);
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
+    iOrderChanged = false;
 }
 
 //============================================================
@@ -254,6 +255,50 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iReferencesByGuid.clear();
+    iOrderChangedRefs.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatList.push_back(hostileRef);
+    iReferencesByGuid[hostileRef->getUnitGuid()] = std::prev(iThreatList.end());
+
+    // new references are appended, update() moves them to their place
+    markOrderChanged(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    auto itr = iReferencesByGuid.find(hostileRef->getUnitGuid());
+    if (itr == iReferencesByGuid.end() || *itr->second != hostileRef)
+        return;
+
+    iThreatList.erase(itr->second);
+    iReferencesByGuid.erase(itr);
+
+    if (hostileRef->iOrderChanged)
+    {
+        hostileRef->iOrderChanged = false;
+        auto changedItr = std::find(iOrderChangedRefs.begin(), iOrderChangedRefs.end(), hostileRef);
+        if (changedItr != iOrderChangedRefs.end())
+            iOrderChangedRefs.erase(changedItr);
+    }
+}
+
+//============================================================
+
+void ThreatContainer::markOrderChanged(HostileReference* hostileRef)
+{
+    if (hostileRef->iOrderChanged)
+        return;
+
+    hostileRef->iOrderChanged = true;
+    iOrderChangedRefs.push_back(hostileRef);
 }
 
 //============================================================
@@ -268,16 +313,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit const* victim) cons
 
 HostileReference* ThreatContainer::getReferenceByTarget(ObjectGuid const& guid) const
 {
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-        {
-            return ref;
-        }
-    }
-
-    return nullptr;
+    auto itr = iReferencesByGuid.find(guid);
+    return itr != iReferencesByGuid.end() ? *itr->second : nullptr;
 }
 
 //============================================================
@@ -300,12 +337,29 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Only the references whose threat changed since the last update can be out of order,
+// take them out, sort them and merge them back into the still sorted rest of the list.
+// The list itself is not reordered between updates, so it is safe to change threat while iterating it.
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Acore::ThreatOrderPred());
+    if (!iOrderChangedRefs.empty())
+    {
+        if (iThreatList.size() > 1)
+        {
+            StorageType changedRefs;
+            for (HostileReference* ref : iOrderChangedRefs)
+                changedRefs.splice(changedRefs.end(), iThreatList, iReferencesByGuid.at(ref->getUnitGuid()));
+
+            changedRefs.sort(Acore::ThreatOrderPred());
+            iThreatList.merge(changedRefs, Acore::ThreatOrderPred());
+        }
+
+        for (HostileReference* ref : iOrderChangedRefs)
+            ref->iOrderChanged = false;
+
+        iOrderChangedRefs.clear();
+    }
 
     iDirty = false;
 }
@@ -591,6 +645,8 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            if (hostileRef->IsOnline())
+                iThreatContainer.markOrderChanged(hostileRef);
             if ((getCurrentVictim() == hostileRef && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
                     (getCurrentVictim() != hostileRef && threatRefStatusChangeEvent->getFValue() > 0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
@@ -614,8 +670,8 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
             {
                 if (getCurrentVictim() && hostileRef->GetThreat() > (1.1f * getCurrentVictim()->GetThreat()))
                     setDirty(true);
-                iThreatContainer.addReference(hostileRef);
                 iThreatOfflineContainer.remove(hostileRef);
+                iThreatContainer.addReference(hostileRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -24,6 +24,8 @@
 #include "SharedDefines.h"
 #include "UnitEvents.h"
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
@@ -46,6 +48,8 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatMgr>
 {
+    friend class ThreatContainer;
+
 public:
     HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float threat);
 
@@ -134,6 +138,7 @@ private:
     float iTempThreatModifier;                          // used for taunt
     ObjectGuid iUnitGuid;
     bool iOnline;
+    bool iOrderChanged;                                 // threat changed since the list was last ordered
 };
 
 //==============================================================
@@ -176,22 +181,21 @@ public:
     [[nodiscard]] StorageType const& GetThreatList() const { return iThreatList; }
 
 private:
-    void remove(HostileReference* hostileRef)
-    {
-        iThreatList.remove(hostileRef);
-    }
+    void remove(HostileReference* hostileRef);
 
-    void addReference(HostileReference* hostileRef)
-    {
-        iThreatList.push_back(hostileRef);
-    }
+    void addReference(HostileReference* hostileRef);
+
+    // The threat of the reference changed, its position is fixed by the next update()
+    void markOrderChanged(HostileReference* hostileRef);
 
     void clearReferences();
 
-    // Sort the list if necessary
+    // Put the changed references back in threat order
     void update();
 
     StorageType iThreatList;
+    std::unordered_map<ObjectGuid, StorageType::iterator> iReferencesByGuid;
+    std::vector<HostileReference*> iOrderChangedRefs;
     bool iDirty{false};
 };
 
@@ -18,6 +18,7 @@
 #include "Creature.h"
 #include "BattlegroundMgr.h"
 #include "CellImpl.h"
+#include "CombatAI.h"
 #include "Common.h"
 #include "CreatureAI.h"
 #include "CreatureAISelector.h"
@@ -29,18 +30,23 @@
 #include "GridNotifiers.h"
 #include "Group.h"
 #include "GroupMgr.h"
+#include "GuardAI.h"
 #include "Log.h"
 #include "LootMgr.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
+#include "PassiveAI.h"
 #include "Pet.h"
+#include "PetAI.h"
 #include "Player.h"
 #include "PoolMgr.h"
+#include "ReactorAI.h"
 #include "ScriptMgr.h"
 #include "ScriptedGossip.h"
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
+#include "TotemAI.h"
 #include "Transport.h"
 #include "Util.h"
 #include "Vehicle.h"
@@ -54,6 +60,7 @@
 //  there is probably some underlying problem with imports which should properly addressed
 //  see: https://github.com/azerothcore/azerothcore-wotlk/issues/9766
 #include "GridNotifiersImpl.h"
+#include <typeinfo>
 
 CreatureMovementData::CreatureMovementData() : Ground(CreatureGroundMovementType::Run), Flight(CreatureFlightMovementType::None),
                                                Swim(true), Rooted(false), Chase(CreatureChaseMovementType::Run),
@@ -274,6 +281,7 @@ Creature::Creature(bool isWorldObject): Unit(isWorldObject), MovableMapObject(),
     m_transportCheckTimer(1000), lootPickPocketRestoreTime(0), m_combatPulseTime(0), m_combatPulseDelay(0), m_reactState(REACT_AGGRESSIVE), m_defaultMovementType(IDLE_MOTION_TYPE),
     m_spawnId(0), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false),
     m_AlreadySearchedAssistance(false), m_regenHealth(true), m_regenPower(true), m_AI_locked(false), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0), m_moveInLineOfSightDisabled(false), m_moveInLineOfSightStrictlyDisabled(false),
+    m_sightReactionUpdateTime(Milliseconds::min()), m_sightReactionRadius(-1.0f), m_alertReactionRadius(-1.0f), m_sightReactionUnlimited(true),
     m_homePosition(), m_transportHomePosition(), m_creatureInfo(nullptr), m_creatureData(nullptr), m_detectionDistance(20.0f),_sparringPct(0.0f), m_waypointID(0), m_path_id(0), m_formation(nullptr), m_lastLeashExtensionTime(nullptr), m_cannotReachTimer(0),
     _isMissingSwimmingFlagOutOfCombat(false), m_assistanceTimer(0), _playerDamageReq(0), _damagedByPlayer(false), _isCombatMovementAllowed(true)
 {
@@ -1190,6 +1198,7 @@ bool Creature::AIM_Initialize(CreatureAI* ai)
     delete oldAI;
     IsAIEnabled = true;
     i_AI->InitializeAI();
+    InvalidateSightReactionRange();
 
     // Xinef: Initialize vehicle if it is not summoned!
     if (GetVehicleKit() && m_spawnId)
@@ -2049,6 +2058,7 @@ bool Creature::CanStartAttack(Unit const* who) const
 void Creature::setDeathState(DeathState state, bool despawn)
 {
     Unit::setDeathState(state, despawn);
+    InvalidateSightReactionRange();
 
     if (state == DeathState::JustDied)
     {
@@ -2673,6 +2683,8 @@ bool Creature::_IsTargetAcceptable(Unit const* target) const
 
 void Creature::UpdateMoveInLineOfSightState()
 {
+    InvalidateSightReactionRange();
+
     // xinef: pets, guardians and units with scripts / smartAI should be skipped
     if (IsPet() || HasUnitTypeMask(UNIT_MASK_MINION | UNIT_MASK_SUMMON | UNIT_MASK_GUARDIAN | UNIT_MASK_CONTROLLABLE_GUARDIAN) ||
             GetScriptId() || GetAIName() == "SmartAI")
@@ -2700,6 +2712,72 @@ void Creature::UpdateMoveInLineOfSightState()
         m_moveInLineOfSightDisabled = false;
 }
 
+bool Creature::IsInSightReactionRange(Unit const* who)
+{
+    Milliseconds now = GameTime::GetGameTimeMS();
+    if (m_sightReactionUpdateTime != now)
+    {
+        UpdateSightReactionRange();
+        m_sightReactionUpdateTime = now;
+    }
+
+    if (m_sightReactionUnlimited)
+        return true;
+
+    float radius = m_sightReactionRadius;
+
+    // the stealth alert range grows with the detected range auras of the player
+    if (m_alertReactionRadius >= 0.0f && who->IsPlayer() && who->HasStealthAura())
+    {
+        float alertRadius = m_alertReactionRadius + std::max(0, who->GetTotalAuraModifier(SPELL_AURA_MOD_DETECTED_RANGE)) * sWorld->getRate(RATE_CREATURE_AGGRO);
+        radius = std::max(radius, alertRadius);
+    }
+
+    if (radius < 0.0f)
+        return false;
+
+    // CanStartAttack and CreatureAI::MoveInLineOfSight include the bounding radius of the target
+    radius += who->GetObjectSize();
+    return GetExactDist2dSq(who) <= radius * radius;
+}
+
+void Creature::UpdateSightReactionRange()
+{
+    m_sightReactionRadius = -1.0f;
+    m_alertReactionRadius = -1.0f;
+
+    // only the core AIs are known to react within the aggro range, everything else (scripts, SmartAI, AIs derived from the core ones)
+    // may react to any unit it is told about
+    CreatureAI const* ai = AI();
+    if (!ai)
+    {
+        m_sightReactionUnlimited = true;
+        return;
+    }
+
+    std::type_info const& aiType = typeid(*ai);
+    m_sightReactionUnlimited = aiType != typeid(AggressorAI) && aiType != typeid(CombatAI) && aiType != typeid(CasterAI) &&
+        aiType != typeid(ArcherAI) && aiType != typeid(TurretAI) && aiType != typeid(VehicleAI) && aiType != typeid(ReactorAI) &&
+        aiType != typeid(PassiveAI) && aiType != typeid(PossessedAI) && aiType != typeid(NullCreatureAI) && aiType != typeid(CritterAI) &&
+        aiType != typeid(TriggerAI) && aiType != typeid(GuardAI) && aiType != typeid(PetAI) && aiType != typeid(TotemAI);
+
+    if (m_sightReactionUnlimited)
+        return;
+
+    // CreatureAI::MoveInLineOfSight and CreatureAI::TriggerAlert do nothing for these
+    if (!IsAlive() || IsEngaged() || IsCivilian() || HasReactState(REACT_PASSIVE))
+        return;
+
+    float aggroRate = sWorld->getRate(RATE_CREATURE_AGGRO);
+
+    // CanStartAttack: the aggro range is capped at MAX_AGGRO_RADIUS, creatures not hostile to anyone only assist within ATTACK_DISTANCE
+    if (HasReactState(REACT_AGGRESSIVE))
+        m_sightReactionRadius = IsMoveInLineOfSightDisabled() ? ATTACK_DISTANCE : MAX_AGGRO_RADIUS * aggroRate + m_CombatDistance;
+
+    // CanDetectStealthOf: an alert is only raised closer than GetAttackDistance, which is at most 45 yards before the range auras
+    m_alertReactionRadius = (MAX_AGGRO_RADIUS + std::max(0, GetTotalAuraModifier(SPELL_AURA_MOD_DETECT_RANGE))) * aggroRate + m_CombatDistance;
+}
+
 void Creature::SaveRespawnTime()
 {
     if (IsSummon() || !m_spawnId || (m_creatureData && !m_creatureData->dbData))
@@ -3992,5 +4070,9 @@ bool Creature::IsUpdateNeeded()
     if (HasUnitState(UNIT_STATE_EVADE))
         return true;
 
+    // with reduced rate updates pending events (delayed despawns, spell events) keep running instead of waiting for a player
+    if (!m_Events.Empty() && sWorld->getIntConfig(CONFIG_INTERVAL_MAPUPDATE_REDUCED_RATE))
+        return true;
+
     return false;
 }
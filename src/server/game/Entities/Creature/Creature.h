@@ -122,7 +122,7 @@
      * - 被动：生物不会攻击任何人
      * - 中立：只有被攻击时才会反击
      */
-     void SetReactState(ReactStates state) { m_reactState = state; }
+     void SetReactState(ReactStates state) { m_reactState = state; InvalidateSightReactionRange(); }
      // 获取反应状态
      [[nodiscard]] ReactStates GetReactState() const { return m_reactState; }
      // 检查是否具有指定反应状态
@@ -429,6 +429,11 @@
      bool IsMoveInLineOfSightDisabled() { return m_moveInLineOfSightDisabled; }
      // 检查是否严格禁用视线移动
      bool IsMoveInLineOfSightStrictlyDisabled() { return m_moveInLineOfSightStrictlyDisabled; }
+     // 检查单位是否在本生物可能响应的距离内（MoveInLineOfSight 或潜行警觉），用于在视线通知前过滤
+     // 只有核心 AI 按仇恨距离过滤，脚本 AI 总是收到通知；距离在每次世界更新中最多计算一次
+     bool IsInSightReactionRange(Unit const* who);
+     // 反应状态、存活、战斗或 AI 变化后调用，下次过滤时重新计算响应距离
+     void InvalidateSightReactionRange() { m_sightReactionUpdateTime = Milliseconds::min(); }
  
      // 移除尸体
      void RemoveCorpse(bool setSpawnTime = true, bool skipVisibility = false);
@@ -727,6 +732,13 @@
      bool m_moveInLineOfSightDisabled;
      // 移动视线严格禁用
      bool m_moveInLineOfSightStrictlyDisabled;
+
+     // 计算本次世界更新的视线响应距离
+     void UpdateSightReactionRange();
+     Milliseconds m_sightReactionUpdateTime;   // 上次计算响应距离时的游戏时间
+     float m_sightReactionRadius;              // MoveInLineOfSight 可能生效的距离，负值表示不会响应
+     float m_alertReactionRadius;              // 潜行警觉可能生效的距离（不含目标身上的光环），负值表示不会响应
+     bool m_sightReactionUnlimited;            // 脚本 AI，不按距离过滤
  
      // 家的位置
      Position m_homePosition;
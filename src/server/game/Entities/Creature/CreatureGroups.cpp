@@ -354,6 +354,18 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
     float pathDist = m_leader->GetExactDist(x, y, z);
     float pathAngle = std::atan2(m_leader->GetPositionY() - y, m_leader->GetPositionX() - x);
 
+    // Xinef: this should be automatized, if turn angle is greater than PI/2 (90�) we should swap formation angle
+    // pussywizard: in both cases should be 2*M_PI - follow_angle
+    // pussywizard: also, GetCurrentWaypointID() returns 0..n-1, while point_1 must be > 0, so +1
+    // pussywizard: db table waypoint_data shouldn't have point id 0 and shouldn't have any gaps for this to work!
+    // if (m_leader->GetCurrentWaypointID()+1 == pFormationInfo->point_1 || m_leader->GetCurrentWaypointID()+1 == itr->second->point_2)
+    bool const swapFollowAngle = static_cast<float>(M_PI) - std::fabs(std::fabs(m_leader->GetOrientation() - pathAngle) - static_cast<float>(M_PI)) > static_cast<float>(M_PI) * 0.5f;
+
+    // plan the destinations of all following members first, so the terrain under them is looked up in one go
+    m_movePlan.clear();
+    m_movePlanX.clear();
+    m_movePlanY.clear();
+
     for (auto const& itr : m_members)
     {
         Creature* member = itr.first;
@@ -365,30 +377,54 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
         if (member->HasUnitState(UNIT_STATE_NOT_MOVE))
             continue;
 
-        // Xinef: this should be automatized, if turn angle is greater than PI/2 (90�) we should swap formation angle
         float followAngle = pFormationInfo.follow_angle;
-        if (static_cast<float>(M_PI) - std::fabs(std::fabs(m_leader->GetOrientation() - pathAngle) - static_cast<float>(M_PI)) > static_cast<float>(M_PI)* 0.5f)
-        {
-            // pussywizard: in both cases should be 2*M_PI - follow_angle
-            // pussywizard: also, GetCurrentWaypointID() returns 0..n-1, while point_1 must be > 0, so +1
-            // pussywizard: db table waypoint_data shouldn't have point id 0 and shouldn't have any gaps for this to work!
-            // if (m_leader->GetCurrentWaypointID()+1 == pFormationInfo->point_1 || m_leader->GetCurrentWaypointID()+1 == itr->second->point_2)
+        if (swapFollowAngle)
             followAngle = Position::NormalizeOrientation(pFormationInfo.follow_angle + static_cast<float>(M_PI)); //(2 * M_PI) - itr->second->follow_angle;
-        }
 
         float const followDist = pFormationInfo.follow_dist;
 
         float dx = x + std::cos(followAngle + pathAngle) * followDist;
         float dy = y + std::sin(followAngle + pathAngle) * followDist;
-        float dz = z;
 
         Acore::NormalizeMapCoord(dx);
         Acore::NormalizeMapCoord(dy);
-        if (move_type < 2)
-            member->UpdateGroundPositionZ(dx, dy, dz);
+
+        m_movePlan.push_back({ member, dx, dy, z });
+        m_movePlanX.push_back(dx);
+        m_movePlanY.push_back(dy);
+    }
+
+    if (m_movePlan.empty())
+        return;
+
+    if (move_type < 2)
+    {
+        // the members stand next to each other, their grid heights come from the same terrain data
+        Map* map = m_leader->GetMap();
+        m_movePlanGridZ.resize(m_movePlan.size());
+        map->GetGridHeights(m_movePlanX.data(), m_movePlanY.data(), m_movePlanGridZ.data(), uint32(m_movePlan.size()));
+
+        for (std::size_t i = 0; i < m_movePlan.size(); ++i)
+        {
+            // same as Creature::UpdateGroundPositionZ with the grid height looked up already
+            MemberMovePlan& plan = m_movePlan[i];
+            float searchZ = plan.Z;
+            if (searchZ != MAX_HEIGHT)
+                searchZ += std::max(plan.Member->GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT);
+            float const groundZ = map->GetHeightWithGridHeight(plan.Member->GetPhaseMask(), m_movePlanGridZ[i], plan.X, plan.Y, searchZ, true, DEFAULT_HEIGHT_SEARCH);
+            if (groundZ > INVALID_HEIGHT)
+                plan.Z = groundZ + plan.Member->GetHoverHeight();
+        }
+    }
+
+    uint32 const leaderMovementFlags = m_leader->GetUnitMovementFlags();
+
+    for (MemberMovePlan const& plan : m_movePlan)
+    {
+        Creature* member = plan.Member;
 
         // pussywizard: setting the same movementflags is not enough, spline decides whether leader walks/runs, so spline param is now passed as "run" parameter to this function
-        member->SetUnitMovementFlags(m_leader->GetUnitMovementFlags());
+        member->SetUnitMovementFlags(leaderMovementFlags);
         switch (move_type)
         {
         case WAYPOINT_MOVE_TYPE_WALK:
@@ -405,13 +441,13 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
         // xinef: if we move members to position without taking care of sizes, we should compare distance without sizes
         // xinef: change members speed basing on distance - if too far speed up, if too close slow down
         UnitMoveType const mtype = Movement::SelectSpeedType(member->GetUnitMovementFlags());
-        float const speedRate = m_leader->GetSpeedRate(mtype) * member->GetExactDist(dx, dy, dz) / pathDist;
+        float const speedRate = m_leader->GetSpeedRate(mtype) * member->GetExactDist(plan.X, plan.Y, plan.Z) / pathDist;
 
         if (speedRate > 0.01f) // don't move if speed rate is too low
         {
             member->SetSpeedRate(mtype, speedRate);
-            member->GetMotionMaster()->MovePoint(0, dx, dy, dz);
-            member->SetHomePosition(dx, dy, dz, pathAngle);
+            member->GetMotionMaster()->MovePoint(0, plan.X, plan.Y, plan.Z);
+            member->SetHomePosition(plan.X, plan.Y, plan.Z, pathAngle);
         }
     }
 }
@@ -23,6 +23,7 @@
  #include "Unit.h"
  #include <map>
  #include <unordered_map>
+ #include <vector>
  
  class Creature;
  class CreatureGroup;
@@ -143,8 +144,19 @@
      [[nodiscard]] bool IsAnyMemberAlive(bool ignoreLeader = false);
  
  private:
+     // LeaderMoveTo 为一名跟随成员规划的目的地
+     struct MemberMovePlan
+     {
+         Creature* Member;
+         float X, Y, Z;
+     };
+
      Creature* m_leader; // 领袖指针
      CreatureGroupMemberType m_members; // 成员列表
+
+     // LeaderMoveTo 复用的缓冲区：跟随成员的目的地，以及批量查询地形高度用的坐标和网格高度
+     std::vector<MemberMovePlan> m_movePlan;
+     std::vector<float> m_movePlanX, m_movePlanY, m_movePlanGridZ;
  
      uint32 m_groupID;    // 群体ID
      bool m_Formed;       // 是否已形成
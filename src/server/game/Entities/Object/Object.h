@@ -622,7 +622,7 @@ public:
 
 protected:
     // 构造函数，初始化更新列表偏移量和更新状态
-    UpdatableMapObject() : _mapUpdateListOffset(0), _mapUpdateState(NotUpdating) { }
+    UpdatableMapObject() : _mapUpdateListOffset(0), _mapUpdateState(NotUpdating), _mapUpdateSuspendTime(Milliseconds::zero()) { }
 
 private:
     // 设置地图更新列表偏移量
@@ -651,11 +651,25 @@ private:
         return _mapUpdateState;
     }
 
+    // 设置因远离玩家被移出更新列表的游戏时间，零表示没有需要补上的时间
+    void SetMapUpdateSuspendTime(Milliseconds time)
+    {
+        _mapUpdateSuspendTime = time;
+    }
+
+    // 获取被移出更新列表的游戏时间
+    Milliseconds GetMapUpdateSuspendTime() const
+    {
+        return _mapUpdateSuspendTime;
+    }
+
 private:
     // 地图更新列表偏移量
     std::size_t _mapUpdateListOffset;
     // 更新状态
     UpdateState _mapUpdateState;
+    // 被移出更新列表的游戏时间
+    Milliseconds _mapUpdateSuspendTime;
 };
 
 // 世界对象类，继承自 Object 和 WorldLocation，代表世界中的对象
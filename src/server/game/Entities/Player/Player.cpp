@@ -319,6 +319,9 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
 
     m_baseSpellPower = 0;
     m_baseFeralAP = 0;
+    m_statUpdateBatchDepth = 0;
+    m_pendingStatUpdates = 0;
+    m_runningStatUpdate = 0;
     m_baseManaRegen = 0;
     m_baseHealthRegen = 0;
     m_spellPenetrationItemMod = 0;
@@ -6592,6 +6595,9 @@ void Player::_ApplyItemMods(Item* item, uint8 slot, bool apply)
 
     LOG_DEBUG("entities.player", "applying mods for item {} ", item->GetGUID().ToString());
 
+    // the bonuses, equip spells and enchantments of the item recalculate the stats once
+    StatUpdateBatch statBatch(this);
+
     uint8 attacktype = Player::GetAttackBySlot(slot);
 
     if (item->HasSocket())                              //only (un)equipping of items with sockets can influence metagems, so no need to waste time with normal items
@@ -7515,6 +7521,8 @@ void Player::_RemoveAllItemMods()
 {
     LOG_DEBUG("entities.player.items", "_RemoveAllItemMods start.");
 
+    StatUpdateBatch statBatch(this);
+
     for (uint8 i = 0; i < INVENTORY_SLOT_BAG_END; ++i)
     {
         if (m_items[i])
@@ -7563,6 +7571,8 @@ void Player::_ApplyAllItemMods()
 {
     LOG_DEBUG("entities.player.items", "_ApplyAllItemMods start.");
 
+    StatUpdateBatch statBatch(this);
+
     for (uint8 i = 0; i < INVENTORY_SLOT_BAG_END; ++i)
     {
         if (m_items[i])
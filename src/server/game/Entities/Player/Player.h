@@ -703,6 +703,29 @@ enum PlayerExtraFlags
     PLAYER_EXTRA_GM_SPECTATOR = 0x0800, // 游戏管理员观察者
 };
 
+// 可以推迟的派生属性重算，位的顺序即重算顺序：每一项只依赖基础属性和排在它前面的项
+// 属性值、最大生命值和最大资源值不推迟，光环处理函数会在修改后立即读取它们来保持生命和资源的百分比
+enum PlayerStatUpdateFlags : uint32
+{
+    PLAYER_STAT_UPDATE_RESISTANCE_HOLY      = 0x00000001, // 抗性：基础值、光环、按属性百分比转换
+    PLAYER_STAT_UPDATE_RESISTANCE_FIRE      = 0x00000002,
+    PLAYER_STAT_UPDATE_RESISTANCE_NATURE    = 0x00000004,
+    PLAYER_STAT_UPDATE_RESISTANCE_FROST     = 0x00000008,
+    PLAYER_STAT_UPDATE_RESISTANCE_SHADOW    = 0x00000010,
+    PLAYER_STAT_UPDATE_RESISTANCE_ARCANE    = 0x00000020,
+    PLAYER_STAT_UPDATE_ARMOR                = 0x00000040, // 护甲：物品、敏捷、光环 -> 近战攻击强度
+    PLAYER_STAT_UPDATE_SHIELD_BLOCK_VALUE   = 0x00000080, // 盾牌格挡值：力量、物品
+    PLAYER_STAT_UPDATE_ATTACK_POWER         = 0x00000100, // 近战攻击强度：力量、敏捷、护甲、光环 -> 法术强度
+    PLAYER_STAT_UPDATE_RANGED_ATTACK_POWER  = 0x00000200, // 远程攻击强度：敏捷、光环
+    PLAYER_STAT_UPDATE_CRIT                 = 0x00000400, // 物理暴击：敏捷、评分
+    PLAYER_STAT_UPDATE_DODGE                = 0x00000800, // 闪避：敏捷、防御、评分
+    PLAYER_STAT_UPDATE_PARRY                = 0x00001000, // 招架：防御、评分
+    PLAYER_STAT_UPDATE_BLOCK                = 0x00002000, // 格挡：防御、评分
+    PLAYER_STAT_UPDATE_SPELL_CRIT           = 0x00004000, // 法术暴击：智力、评分
+    PLAYER_STAT_UPDATE_SPELL_POWER          = 0x00008000, // 法术伤害和治疗加成：属性、攻击强度、光环
+    PLAYER_STAT_UPDATE_MANA_REGEN           = 0x00010000, // 法力恢复：智力、精神、光环
+};
+
 // 2 的幂值，登录时标志枚举
 enum AtLoginFlags
 {
@@ -2182,6 +2205,11 @@ public:
     void UpdateEnergyRegen(); // 更新能量恢复
     void UpdateRuneRegen(RuneType rune); // 更新符文恢复
 
+    // 开始推迟派生属性的重算，可以嵌套，见 StatUpdateBatch
+    void BeginStatUpdateBatch() { ++m_statUpdateBatchDepth; }
+    // 结束推迟，离开最外层时按依赖顺序把每个待重算的属性重算一次
+    void EndStatUpdateBatch();
+
     [[nodiscard]] ObjectGuid GetLootGUID() const { return m_lootGuid; } // 获取掠夺GUID
     void SetLootGUID(ObjectGuid guid) { m_lootGuid = guid; } // 设置掠夺GUID
 
@@ -3022,6 +3050,13 @@ protected:
     uint32 m_baseHealthRegen; // 基础生命回复
     int32 m_spellPenetrationItemMod; // 法术穿透物品修改值
 
+    bool DeferStatUpdate(PlayerStatUpdateFlags update); // 推迟期间记录待重算的属性并返回 true
+    void ApplyStatUpdate(PlayerStatUpdateFlags update); // 重算一项派生属性
+
+    uint32 m_statUpdateBatchDepth; // 属性重算推迟的嵌套层数
+    uint32 m_pendingStatUpdates; // 待重算的属性，PlayerStatUpdateFlags
+    uint32 m_runningStatUpdate; // 正在重算的属性
+
     SpellModList m_spellMods[MAX_SPELLMOD]; // 法术修改列表
     //uint32 m_pad;
     //        Spell* m_spellModTakingSpell;  // 用于在Spell::finish中消耗充能的法术
@@ -3210,6 +3245,29 @@ private:
     Seconds m_creationTime;  // 玩家角色创建时间
 };
 
+// 作用域内推迟玩家派生属性的重算，一次装备更换或一个光环的全部效果只触发一轮重算
+class StatUpdateBatch
+{
+public:
+    explicit StatUpdateBatch(Unit* unit) : _player(unit->ToPlayer())
+    {
+        if (_player)
+            _player->BeginStatUpdateBatch();
+    }
+
+    ~StatUpdateBatch()
+    {
+        if (_player)
+            _player->EndStatUpdateBatch();
+    }
+
+    StatUpdateBatch(StatUpdateBatch const&) = delete;
+    StatUpdateBatch& operator=(StatUpdateBatch const&) = delete;
+
+private:
+    Player* _player;
+};
+
 void AddItemsSetItem(Player* player, Item* item);       // 将物品添加到玩家的物品集合中
 void RemoveItemsSetItem(Player* player, ItemTemplate const* proto);  // 从玩家的物品集合中移除指定类型的物品模板
 #endif
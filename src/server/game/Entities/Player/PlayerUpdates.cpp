@@ -307,7 +307,8 @@ void Player::Update(uint32 p_time)
             m_zoneUpdateTimer -= p_time;
     }
 
-    sScriptMgr->OnPlayerUpdate(this, p_time);
+    if (ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_UPDATE))
+        sScriptMgr->OnPlayerUpdate(this, p_time);
 
     if (IsAlive())
     {
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PROCAURAINDEX_H
+#define _PROCAURAINDEX_H
+
+#include "Define.h"
+#include <array>
+#include <map>
+
+// 可能触发的增益索引
+// 只保存能够通过旧触发系统（spell_proc_event / SpellInfo::ProcFlags）触发的增益，
+// 与 Unit::m_appliedAuras 一样按 SpellID 排序，相同 SpellID 保持插入顺序，
+// 因此遍历顺序与直接遍历 m_appliedAuras 一致
+template<class T>
+class ProcAuraIndex
+{
+public:
+    struct Candidate
+    {
+        T* Application = nullptr;
+        uint32 ProcFlags = 0;       // 可以触发的 PROC_FLAG_* 掩码
+        uint32 ProcPhases = 0;      // 可以触发的 PROC_SPELL_PHASE_* 掩码，0 表示不限阶段
+        bool AlwaysCheck = false;   // 有 CheckProc 脚本的增益，每次都需要检查
+
+        [[nodiscard]] bool Matches(uint32 procFlag, uint32 procPhase) const
+        {
+            return AlwaysCheck || ((ProcFlags & procFlag) && (!ProcPhases || (ProcPhases & procPhase)));
+        }
+    };
+
+    typedef std::multimap<uint32, Candidate> CandidateMap;
+    typedef typename CandidateMap::const_iterator const_iterator;
+
+    void Insert(uint32 spellId, Candidate const& candidate)
+    {
+        _candidates.insert(typename CandidateMap::value_type(spellId, candidate));
+        AddMasks(candidate, 1);
+    }
+
+    void Remove(uint32 spellId, T const* application)
+    {
+        auto range = _candidates.equal_range(spellId);
+        for (auto itr = range.first; itr != range.second; ++itr)
+        {
+            if (itr->second.Application == application)
+            {
+                AddMasks(itr->second, -1);
+                _candidates.erase(itr);
+                return;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        _candidates.clear();
+        _flagCounts.fill(0);
+        _procFlags = 0;
+        _alwaysCheckCount = 0;
+    }
+
+    // 是否有增益可能被此次事件触发，用于在遍历前快速排除
+    [[nodiscard]] bool HasCandidates(uint32 procFlag) const
+    {
+        return _alwaysCheckCount || (_procFlags & procFlag);
+    }
+
+    [[nodiscard]] uint32 GetProcFlags() const { return _procFlags; }
+    [[nodiscard]] std::size_t GetSize() const { return _candidates.size(); }
+    [[nodiscard]] bool IsEmpty() const { return _candidates.empty(); }
+
+    // 索引建立时触发数据的版本，触发数据重载后需要重建索引
+    [[nodiscard]] uint32 GetGeneration() const { return _generation; }
+    void SetGeneration(uint32 generation) { _generation = generation; }
+
+    [[nodiscard]] const_iterator begin() const { return _candidates.begin(); }
+    [[nodiscard]] const_iterator end() const { return _candidates.end(); }
+
+private:
+    void AddMasks(Candidate const& candidate, int32 delta)
+    {
+        if (candidate.AlwaysCheck)
+            _alwaysCheckCount += delta;
+
+        // 按触发标记位分桶计数，移除增益时无需重新遍历即可得到所有增益的标记并集
+        for (uint8 bit = 0; bit < 32; ++bit)
+        {
+            if (!(candidate.ProcFlags & (1u << bit)))
+                continue;
+
+            _flagCounts[bit] += delta;
+            if (_flagCounts[bit])
+                _procFlags |= 1u << bit;
+            else
+                _procFlags &= ~(1u << bit);
+        }
+    }
+
+    CandidateMap _candidates;
+    std::array<uint32, 32> _flagCounts = { };
+    uint32 _procFlags = 0;
+    uint32 _alwaysCheckCount = 0;
+    uint32 _generation = 0;
+};
+
+#endif
@@ -104,6 +104,9 @@ bool Player::UpdateStats(Stats stat)
 
     SetStat(stat, int32(value));
 
+    // every stat below is recalculated once, even when several of the updates ask for it
+    StatUpdateBatch batch(this);
+
     switch (stat)
     {
         case STAT_STRENGTH:
@@ -176,6 +179,9 @@ void Player::ApplySpellPowerBonus(int32 amount, bool apply)
 
 void Player::UpdateSpellDamageAndHealingBonus()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_SPELL_POWER))
+        return;
+
     // Magic damage modifiers implemented in Unit::SpellDamageBonusDone
     // This information for client side use only
     // Get healing bonus for all schools
@@ -187,6 +193,8 @@ void Player::UpdateSpellDamageAndHealingBonus()
 
 bool Player::UpdateAllStats()
 {
+    StatUpdateBatch batch(this);
+
     for (int8 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         float value = GetTotalStatValue(Stats(i));
@@ -226,6 +234,9 @@ void Player::UpdateResistances(uint32 school)
 {
     if (school > SPELL_SCHOOL_NORMAL)
     {
+        if (DeferStatUpdate(PlayerStatUpdateFlags(PLAYER_STAT_UPDATE_RESISTANCE_HOLY << (school - SPELL_SCHOOL_HOLY))))
+            return;
+
         // cant use GetTotalAuraModValue because of total pct multiplier :P
         float value = 0.0f;
         UnitMods unitMod = UnitMods(UNIT_MOD_RESISTANCE_START + school);
@@ -251,6 +262,9 @@ void Player::UpdateResistances(uint32 school)
 
 void Player::UpdateArmor()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_ARMOR))
+        return;
+
     UnitMods unitMod = UNIT_MOD_ARMOR;
 
     float value = GetModifierValue(unitMod, BASE_VALUE);   // base armor (from items)
@@ -302,7 +316,9 @@ void Player::UpdateMaxHealth()
     value += GetModifierValue(unitMod, TOTAL_VALUE) + GetHealthBonusFromStamina();
     value *= GetModifierValue(unitMod, TOTAL_PCT);
 
-    sScriptMgr->OnPlayerAfterUpdateMaxHealth(this, value);
+    if (ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_AFTER_UPDATE_MAX_HEALTH))
+        sScriptMgr->OnPlayerAfterUpdateMaxHealth(this, value);
+
     SetMaxHealth((uint32)value);
 }
 
@@ -317,7 +333,9 @@ void Player::UpdateMaxPower(Powers power)
     value += GetModifierValue(unitMod, TOTAL_VALUE) +  bonusPower;
     value *= GetModifierValue(unitMod, TOTAL_PCT);
 
-    sScriptMgr->OnPlayerAfterUpdateMaxPower(this, power, value);
+    if (ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_AFTER_UPDATE_MAX_POWER))
+        sScriptMgr->OnPlayerAfterUpdateMaxPower(this, power, value);
+
     SetMaxPower(power, uint32(value));
 }
 
@@ -329,10 +347,14 @@ void Player::ApplyFeralAPBonus(int32 amount, bool apply)
 
 void Player::UpdateAttackPowerAndDamage(bool ranged)
 {
+    if (DeferStatUpdate(ranged ? PLAYER_STAT_UPDATE_RANGED_ATTACK_POWER : PLAYER_STAT_UPDATE_ATTACK_POWER))
+        return;
+
     float val2 = 0.0f;
     float level = float(GetLevel());
 
-    sScriptMgr->OnPlayerBeforeUpdateAttackPowerAndDamage(this, level, val2, ranged);
+    if (ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_BEFORE_UPDATE_ATTACK_POWER_AND_DAMAGE))
+        sScriptMgr->OnPlayerBeforeUpdateAttackPowerAndDamage(this, level, val2, ranged);
 
     UnitMods unitMod = ranged ? UNIT_MOD_ATTACK_POWER_RANGED : UNIT_MOD_ATTACK_POWER;
 
@@ -499,7 +521,9 @@ void Player::UpdateAttackPowerAndDamage(bool ranged)
 
     float attPowerMultiplier = GetModifierValue(unitMod, TOTAL_PCT) - 1.0f;
 
-    sScriptMgr->OnPlayerAfterUpdateAttackPowerAndDamage(this, level, base_attPower, attPowerMod, attPowerMultiplier, ranged);
+    if (ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_AFTER_UPDATE_ATTACK_POWER_AND_DAMAGE))
+        sScriptMgr->OnPlayerAfterUpdateAttackPowerAndDamage(this, level, base_attPower, attPowerMod, attPowerMultiplier, ranged);
+
     SetInt32Value(index, (uint32)base_attPower);            //UNIT_FIELD_(RANGED)_ATTACK_POWER field
     SetInt32Value(index_mod, (uint32)attPowerMod);          //UNIT_FIELD_(RANGED)_ATTACK_POWER_MODS field
     SetFloatValue(index_mult, attPowerMultiplier);          //UNIT_FIELD_(RANGED)_ATTACK_POWER_MULTIPLIER field
@@ -521,6 +545,9 @@ void Player::UpdateAttackPowerAndDamage(bool ranged)
 
 void Player::UpdateShieldBlockValue()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_SHIELD_BLOCK_VALUE))
+        return;
+
     SetUInt32Value(PLAYER_SHIELD_BLOCK, GetShieldBlockValue());
 }
 
@@ -615,6 +642,9 @@ void Player::UpdateDefenseBonusesMod()
 
 void Player::UpdateBlockPercentage()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_BLOCK))
+        return;
+
     // No block
     float value = 0.0f;
     if (CanBlock())
@@ -679,6 +709,9 @@ void Player::UpdateCritPercentage(WeaponAttackType attType)
 
 void Player::UpdateAllCritPercentages()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_CRIT))
+        return;
+
     float value = GetMeleeCritFromAgility();
 
     SetBaseModValue(CRIT_PERCENTAGE, PCT_MOD, value);
@@ -734,6 +767,9 @@ float Player::GetMissPercentageFromDefence() const
 
 void Player::UpdateParryPercentage()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_PARRY))
+        return;
+
     const float parry_cap[MAX_CLASSES] =
     {
         47.003525f,     // Warrior
@@ -780,6 +816,9 @@ void Player::UpdateParryPercentage()
 
 void Player::UpdateDodgePercentage()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_DODGE))
+        return;
+
     const float dodge_cap[MAX_CLASSES] =
     {
         88.129021f,     // Warrior
@@ -870,6 +909,9 @@ void Player::UpdateSpellHitChances()
 
 void Player::UpdateAllSpellCritChances()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_SPELL_CRIT))
+        return;
+
     for (int i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
         UpdateSpellCritChance(i);
 }
@@ -925,6 +967,9 @@ void Player::ApplyHealthRegenBonus(int32 amount, bool apply)
 
 void Player::UpdateManaRegen()
 {
+    if (DeferStatUpdate(PLAYER_STAT_UPDATE_MANA_REGEN))
+        return;
+
     if (HasAuraTypeWithMiscvalue(SPELL_AURA_PREVENT_REGENERATE_POWER, POWER_MANA + 1))
     {
         SetStatFloatValue(UNIT_FIELD_POWER_REGEN_INTERRUPTED_FLAT_MODIFIER, 0);
@@ -988,6 +1033,88 @@ void Player::UpdateRuneRegen(RuneType rune)
     SetFloatValue(PLAYER_RUNE_REGEN_1 + uint8(rune), regen);
 }
 
+bool Player::DeferStatUpdate(PlayerStatUpdateFlags update)
+{
+    if (!m_statUpdateBatchDepth || m_runningStatUpdate == update)
+        return false;
+
+    m_pendingStatUpdates |= update;
+    return true;
+}
+
+void Player::EndStatUpdateBatch()
+{
+    ASSERT(m_statUpdateBatchDepth);
+    if (--m_statUpdateBatchDepth)
+        return;
+
+    // stay in the batch while recalculating, a stat asking for a later one only marks it
+    // the flags are in dependency order, so every pending stat is recalculated once
+    ++m_statUpdateBatchDepth;
+    while (m_pendingStatUpdates)
+    {
+        PlayerStatUpdateFlags update = PlayerStatUpdateFlags(m_pendingStatUpdates & (~m_pendingStatUpdates + 1));
+        m_pendingStatUpdates &= ~update;
+        m_runningStatUpdate = update;
+        ApplyStatUpdate(update);
+    }
+
+    m_runningStatUpdate = 0;
+    --m_statUpdateBatchDepth;
+}
+
+void Player::ApplyStatUpdate(PlayerStatUpdateFlags update)
+{
+    switch (update)
+    {
+        case PLAYER_STAT_UPDATE_RESISTANCE_HOLY:
+        case PLAYER_STAT_UPDATE_RESISTANCE_FIRE:
+        case PLAYER_STAT_UPDATE_RESISTANCE_NATURE:
+        case PLAYER_STAT_UPDATE_RESISTANCE_FROST:
+        case PLAYER_STAT_UPDATE_RESISTANCE_SHADOW:
+        case PLAYER_STAT_UPDATE_RESISTANCE_ARCANE:
+            for (uint32 school = SPELL_SCHOOL_HOLY; school < MAX_SPELL_SCHOOL; ++school)
+                if (update == PLAYER_STAT_UPDATE_RESISTANCE_HOLY << (school - SPELL_SCHOOL_HOLY))
+                    UpdateResistances(school);
+            break;
+        case PLAYER_STAT_UPDATE_ARMOR:
+            UpdateArmor();
+            break;
+        case PLAYER_STAT_UPDATE_SHIELD_BLOCK_VALUE:
+            UpdateShieldBlockValue();
+            break;
+        case PLAYER_STAT_UPDATE_ATTACK_POWER:
+            UpdateAttackPowerAndDamage(false);
+            break;
+        case PLAYER_STAT_UPDATE_RANGED_ATTACK_POWER:
+            UpdateAttackPowerAndDamage(true);
+            break;
+        case PLAYER_STAT_UPDATE_CRIT:
+            UpdateAllCritPercentages();
+            break;
+        case PLAYER_STAT_UPDATE_DODGE:
+            UpdateDodgePercentage();
+            break;
+        case PLAYER_STAT_UPDATE_PARRY:
+            UpdateParryPercentage();
+            break;
+        case PLAYER_STAT_UPDATE_BLOCK:
+            UpdateBlockPercentage();
+            break;
+        case PLAYER_STAT_UPDATE_SPELL_CRIT:
+            UpdateAllSpellCritChances();
+            break;
+        case PLAYER_STAT_UPDATE_SPELL_POWER:
+            UpdateSpellDamageAndHealingBonus();
+            break;
+        case PLAYER_STAT_UPDATE_MANA_REGEN:
+            UpdateManaRegen();
+            break;
+        default:
+            break;
+    }
+}
+
 void Player::_ApplyAllStatBonuses()
 {
     SetCanModifyStats(false);
@@ -48,6 +48,7 @@
 #include "ObjectMgr.h"
 #include "OutdoorPvP.h"
 #include "PassiveAI.h"
+#include "PeriodicAuraLogQueue.h"
 #include "Pet.h"
 #include "PetAI.h"
 #include "Player.h"
@@ -383,7 +384,8 @@ Unit::~Unit()
 void Unit::Update(uint32 p_time)
 {
     // 调用脚本管理器的单位更新回调函数
-    sScriptMgr->OnUnitUpdate(this, p_time);
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_ON_UNIT_UPDATE))
+        sScriptMgr->OnUnitUpdate(this, p_time);
 
     // WARNING! Order of execution here is important, do not change.
     // Spells must be processed with event system BEFORE they go to _UpdateSpells.
@@ -832,8 +834,8 @@ Unit* Unit::getAttackerForHelper() const
 void Unit::UpdateInterruptMask()
 {
     m_interruptMask = 0;
-    for (AuraApplicationList::const_iterator i = m_interruptableAuras.begin(); i != m_interruptableAuras.end(); ++i)
-        m_interruptMask |= (*i)->GetBase()->GetSpellInfo()->AuraInterruptFlags;
+    for (AuraApplication const* aurApp : m_interruptableAuras)
+        m_interruptMask |= aurApp->GetBase()->GetSpellInfo()->AuraInterruptFlags;
 
     if (Spell* spell = m_currentSpells[CURRENT_CHANNELED_SPELL])
         if (spell->getState() == SPELL_STATE_CASTING)
@@ -902,7 +904,8 @@ uint32 Unit::DealDamage(Unit* attacker, Unit* victim, uint32 damage, CleanDamage
     }
 
     // Hook for OnDamage Event
-    sScriptMgr->OnDamage(attacker, victim, damage);
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_ON_DAMAGE))
+        sScriptMgr->OnDamage(attacker, victim, damage);
 
     if (victim->IsPlayer() && attacker != victim)
     {
@@ -1395,7 +1398,8 @@ void Unit::CalculateSpellDamageTaken(SpellNonMeleeDamage* damageInfo, int32 dama
     uint32 crTypeMask = victim->GetCreatureTypeMask();
 
      // Script Hook For CalculateSpellDamageTaken -- Allow scripts to change the Damage post class mitigation calculations
-    sScriptMgr->ModifySpellDamageTaken(damageInfo->target, damageInfo->attacker, damage, spellInfo);
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_SPELL_DAMAGE_TAKEN))
+        sScriptMgr->ModifySpellDamageTaken(damageInfo->target, damageInfo->attacker, damage, spellInfo);
 
     if (victim->GetAI())
     {
@@ -1650,7 +1654,8 @@ void Unit::CalculateMeleeDamage(Unit* victim, CalcDamageInfo* damageInfo, Weapon
         damage = damageInfo->target->MeleeDamageBonusTaken(this, damage, damageInfo->attackType, nullptr, schoolMask);
 
         // Script Hook For CalculateMeleeDamage -- Allow scripts to change the Damage pre class mitigation calculations
-        sScriptMgr->ModifyMeleeDamage(damageInfo->target, damageInfo->attacker, damage);
+        if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_MELEE_DAMAGE))
+            sScriptMgr->ModifyMeleeDamage(damageInfo->target, damageInfo->attacker, damage);
 
         if (victim->GetAI())
         {
@@ -4595,6 +4600,8 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
     if (AuraStateType aState = aura->GetSpellInfo()->GetAuraState())
         m_auraStateAuras.insert(AuraStateAurasMap::value_type(aState, aurApp));
 
+    AddProcAuraCandidate(aurApp);
+
     aura->_ApplyForTarget(this, caster, aurApp);
     return aurApp;
 }
@@ -4648,11 +4655,14 @@ void Unit::_ApplyAura(AuraApplication* aurApp, uint8 effMask)
 
     aura->HandleAuraSpecificMods(aurApp, caster, true, false);
 
-    // apply effects of the aura
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+    // apply effects of the aura, the stats they change are recalculated once afterwards
     {
-        if (effMask & 1 << i && (!aurApp->GetRemoveMode()))
-            aurApp->_HandleEffect(i, true);
+        StatUpdateBatch statBatch(this);
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        {
+            if (effMask & 1 << i && (!aurApp->GetRemoveMode()))
+                aurApp->_HandleEffect(i, true);
+        }
     }
 
     sScriptMgr->OnAuraApply(this, aura);
@@ -4678,13 +4688,16 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
     Unit* caster = aura->GetCaster();
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
+    m_procAuras.Remove(i->first, aurApp);
     m_appliedAuras.erase(i);
 
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: event if it gets removed, it will be reapplied in a second
     if (aura->GetSpellInfo()->AuraInterruptFlags && this == aura->GetOwner())
     {
-        m_interruptableAuras.remove(aurApp);
+        auto itr = std::find(m_interruptableAuras.begin(), m_interruptableAuras.end(), aurApp);
+        if (itr != m_interruptableAuras.end())
+            m_interruptableAuras.erase(itr);
         UpdateInterruptMask();
     }
 
@@ -4712,10 +4725,13 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
     aura->_UnapplyForTarget(this, caster, aurApp);
 
     // remove effects of the spell - needs to be done after removing aura from lists
-    for (uint8 itr = 0; itr < MAX_SPELL_EFFECTS; ++itr)
     {
-        if (aurApp->HasEffect(itr))
-            aurApp->_HandleEffect(itr, false);
+        StatUpdateBatch statBatch(this);
+        for (uint8 itr = 0; itr < MAX_SPELL_EFFECTS; ++itr)
+        {
+            if (aurApp->HasEffect(itr))
+                aurApp->_HandleEffect(itr, false);
+        }
     }
 
     // all effect mustn't be applied
@@ -4810,6 +4826,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -5295,17 +5313,26 @@ void Unit::RemoveAurasWithInterruptFlags(uint32 flag, uint32 except, bool isAuto
         return;
 
     // interrupt auras
-    for (AuraApplicationList::iterator iter = m_interruptableAuras.begin(); iter != m_interruptableAuras.end();)
+    for (std::size_t i = 0; i < m_interruptableAuras.size();)
     {
-        Aura* aura = (*iter)->GetBase();
-        ++iter;
+        AuraApplication* aurApp = m_interruptableAuras[i];
+        Aura* aura = aurApp->GetBase();
         if ((aura->GetSpellInfo()->AuraInterruptFlags & flag) && (!except || aura->GetId() != except))
         {
             uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aura);
             if (m_removedAurasCount > removedAuras + 1)
-                iter = m_interruptableAuras.begin();
+            {
+                i = 0;
+                continue;
+            }
+
+            // the next application moved into the removed one's place
+            if (i < m_interruptableAuras.size() && m_interruptableAuras[i] != aurApp)
+                continue;
         }
+
+        ++i;
     }
 
     // interrupt channeled spell
@@ -5904,9 +5931,9 @@ bool Unit::HasNegativeAuraWithInterruptFlag(uint32 flag, ObjectGuid guid)
 {
     if (!(m_interruptMask & flag))
         return false;
-    for (AuraApplicationList::iterator iter = m_interruptableAuras.begin(); iter != m_interruptableAuras.end(); ++iter)
+    for (AuraApplication const* aurApp : m_interruptableAuras)
     {
-        if (!(*iter)->IsPositive() && (*iter)->GetBase()->GetSpellInfo()->AuraInterruptFlags & flag && (!guid || (*iter)->GetBase()->GetCasterGUID() == guid))
+        if (!aurApp->IsPositive() && aurApp->GetBase()->GetSpellInfo()->AuraInterruptFlags & flag && (!guid || aurApp->GetBase()->GetCasterGUID() == guid))
             return true;
     }
     return false;
@@ -6029,98 +6056,149 @@ uint32 Unit::GetDoTsByCaster(ObjectGuid casterGUID) const
     return dots;
 }
 
-int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
+void Unit::AuraModifierTotals::Add(int32 amount)
+{
+    Total += amount;
+    AddPct(Multiplier, amount);
+    if (amount > MaxPositive)
+        MaxPositive = amount;
+    if (amount < MaxNegative)
+        MaxNegative = amount;
+}
+
+void Unit::AuraModifierTotals::Add(AuraModifierTotals const& totals)
+{
+    Total += totals.Total;
+    Multiplier *= totals.Multiplier;
+    if (totals.MaxPositive > MaxPositive)
+        MaxPositive = totals.MaxPositive;
+    if (totals.MaxNegative < MaxNegative)
+        MaxNegative = totals.MaxNegative;
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType auratype)
+{
+    auto itr = m_auraModifierAggregates.find(auratype);
+    if (itr != m_auraModifierAggregates.end())
+        itr->second.Valid = false;
+}
+
+Unit::AuraModifierAggregate const& Unit::GetAuraModifierAggregate(AuraType auratype) const
 {
+    AuraModifierAggregate& aggregate = m_auraModifierAggregates[auratype];
+    if (aggregate.Valid)
+        return aggregate;
+
+    aggregate.Totals = AuraModifierTotals();
+    aggregate.ByMiscValue.clear();
+
     int32 modifier = 0;
     int32 areaModifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    // same order as the list, multipliers are applied one after another like before
+    for (AuraEffect const* aurEff : m_modAuras[auratype])
     {
-        if ((*i)->GetSpellInfo()->HasAreaAuraEffect())
+        int32 amount = aurEff->GetAmount();
+        aggregate.Totals.Add(amount);
+
+        int32 miscValue = aurEff->GetMiscValue();
+        auto itr = std::find_if(aggregate.ByMiscValue.begin(), aggregate.ByMiscValue.end(), [miscValue](std::pair<int32, AuraModifierTotals> const& byMisc)
+        {
+            return byMisc.first == miscValue;
+        });
+
+        if (itr == aggregate.ByMiscValue.end())
+            itr = aggregate.ByMiscValue.emplace(aggregate.ByMiscValue.end(), miscValue, AuraModifierTotals());
+        itr->second.Add(amount);
+
+        if (aurEff->GetSpellInfo()->HasAreaAuraEffect())
         {
-            if (areaModifier < (*i)->GetAmount())
-                areaModifier = (*i)->GetAmount();
+            if (areaModifier < amount)
+                areaModifier = amount;
         }
         else
-            modifier += (*i)->GetAmount();
+            modifier += amount;
     }
 
-    return modifier + areaModifier;
+    aggregate.AreaExclusive = modifier + areaModifier;
+    aggregate.Valid = true;
+    return aggregate;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+Unit::AuraModifierTotals const* Unit::GetAuraModifierTotalsByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    if (mTotalAuraList.empty())
+    if (m_modAuras[auratype].empty())
+        return nullptr;
+
+    for (auto const& [miscValue, totals] : GetAuraModifierAggregate(auratype).ByMiscValue)
+        if (miscValue == misc_value)
+            return &totals;
+
+    return nullptr;
+}
+
+int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
+{
+    if (m_modAuras[auratype].empty())
         return 0;
 
-    int32 modifier = 0;
+    return GetAuraModifierAggregate(auratype).AreaExclusive;
+}
 
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+{
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype).Totals.Total;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
 
-    return multiplier;
+    return GetAuraModifierAggregate(auratype).Totals.Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype).Totals.MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype).Totals.MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
     int32 modifier = 0;
+    for (auto const& [miscValue, totals] : GetAuraModifierAggregate(auratype).ByMiscValue)
+        if (miscValue & misc_mask)
+            modifier += totals.Total;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask)
-            modifier += (*i)->GetAmount();
-    }
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    float multiplier = 1.0f;
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (((*i)->GetMiscValue() & misc_mask))
-            AddPct(multiplier, (*i)->GetAmount());
+    float multiplier = 1.0f;
+    for (auto const& [miscValue, totals] : GetAuraModifierAggregate(auratype).ByMiscValue)
+        if (miscValue & misc_mask)
+            multiplier *= totals.Multiplier;
 
     return multiplier;
 }
@@ -6129,80 +6207,72 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 {
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    // the excluded effect can't be taken out of the cached maximum
+    if (except)
     {
-        if (except != (*i) && (*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
+        AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+        for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+        {
+            if (except != (*i) && (*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() > modifier)
+                modifier = (*i)->GetAmount();
+        }
+
+        return modifier;
     }
 
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    for (auto const& [miscValue, totals] : GetAuraModifierAggregate(auratype).ByMiscValue)
+        if (miscValue & misc_mask && totals.MaxPositive > modifier)
+            modifier = totals.MaxPositive;
+
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+    int32 modifier = 0;
+    for (auto const& [miscValue, totals] : GetAuraModifierAggregate(auratype).ByMiscValue)
+        if (miscValue & misc_mask && totals.MaxNegative < modifier)
+            modifier = totals.MaxNegative;
 
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            modifier += (*i)->GetAmount();
+    if (AuraModifierTotals const* totals = GetAuraModifierTotalsByMiscValue(auratype, misc_value))
+        return totals->Total;
 
-    return modifier;
+    return 0;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
+    if (AuraModifierTotals const* totals = GetAuraModifierTotalsByMiscValue(auratype, misc_value))
+        return totals->Multiplier;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            AddPct(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return 1.0f;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+    if (AuraModifierTotals const* totals = GetAuraModifierTotalsByMiscValue(auratype, misc_value))
+        return totals->MaxPositive;
 
-    return modifier;
+    return 0;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
+    if (AuraModifierTotals const* totals = GetAuraModifierTotalsByMiscValue(auratype, misc_value))
+        return totals->MaxNegative;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return 0;
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -6494,7 +6564,7 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
     //    data << float(log->GlanceChance);
     //    data << float(log->CrushChance);
     //}
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(data, log->attacker->GetGUID(), log->target->GetGUID());
 }
 
 void Unit::SendSpellNonMeleeDamageLog(Unit* target, SpellInfo const* spellInfo, uint32 Damage, SpellSchoolMask damageSchoolMask, uint32 AbsorbedDamage, uint32 Resist, bool PhysicalDamage, uint32 Blocked, bool CriticalHit /*= false*/, bool Split /*= false*/)
@@ -6530,55 +6600,30 @@ void Unit::ProcDamageAndSpell(Unit* actor, Unit* victim, uint32 procAttacker, ui
 
 void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo)
 {
-    AuraEffect const* aura = pInfo->auraEff;
+    if (sWorld->getBoolConfig(CONFIG_BATCH_PERIODIC_AURA_LOG) && IsInWorld())
+    {
+        GetMap()->GetPeriodicAuraLogQueue().Add(this, *pInfo);
+        return;
+    }
+
+    PeriodicAuraLogEntry entry(this, *pInfo);
     WorldPacket data(SMSG_PERIODICAURALOG, 30);
     data << GetPackGUID();
-    data << aura->GetCasterGUID().WriteAsPacked();
-    data << uint32(aura->GetId());                          // spellId
+    data << entry.CasterGUID.WriteAsPacked();
+    data << uint32(entry.SpellId);                          // spellId
     data << uint32(1);                                      // count
-    data << uint32(aura->GetAuraType());                    // auraId
-    switch (aura->GetAuraType())
-    {
-        case SPELL_AURA_PERIODIC_DAMAGE:
-        case SPELL_AURA_PERIODIC_DAMAGE_PERCENT:
-            {
-                //IF we are in cheat mode we swap absorb with damage and set damage to 0, this way we can still debug damage but our hp bar will not drop
-                uint32 damage = pInfo->damage;
-                uint32 absorb = pInfo->absorb;
-                if (IsPlayer() && ToPlayer()->GetCommandStatus(CHEAT_GOD))
-                {
-                    absorb = damage;
-                    damage = 0;
-                }
+    if (!entry.Write(data))
+        return;
 
-                data << uint32(damage);                         // damage
-                data << uint32(pInfo->overDamage);              // overkill?
-                data << uint32(aura->GetSpellInfo()->GetSchoolMask());
-                data << uint32(absorb);                         // absorb
-                data << uint32(pInfo->resist);                  // resist
-                data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
-            }
-            break;
-        case SPELL_AURA_PERIODIC_HEAL:
-        case SPELL_AURA_OBS_MOD_HEALTH:
-            data << uint32(pInfo->damage);                  // damage
-            data << uint32(pInfo->overDamage);              // overheal
-            data << uint32(pInfo->absorb);                  // absorb
-            data << uint8(pInfo->critical);                 // new 3.1.2 critical tick
-            break;
-        case SPELL_AURA_OBS_MOD_POWER:
-        case SPELL_AURA_PERIODIC_ENERGIZE:
-            data << uint32(aura->GetMiscValue());           // power type
-            data << uint32(pInfo->damage);                  // damage
-            break;
-        case SPELL_AURA_PERIODIC_MANA_LEECH:
-            data << uint32(aura->GetMiscValue());           // power type
-            data << uint32(pInfo->damage);                  // amount
-            data << float(pInfo->multiplier);               // gain multiplier
-            break;
-        default:
-            LOG_ERROR("entities.unit", "Unit::SendPeriodicAuraLog: unknown aura {}", uint32(aura->GetAuraType()));
-            return;
+    SendCombatLogMessage(data, entry.CasterGUID, GetGUID());
+}
+
+void Unit::SendCombatLogMessage(WorldPacket& data, ObjectGuid const& attackerGUID, ObjectGuid const& victimGUID)
+{
+    if (sWorld->getBoolConfig(CONFIG_COMBAT_LOG_DISPATCHER) && IsInWorld())
+    {
+        GetMap()->GetCombatLogDispatcher().Queue(this, attackerGUID, victimGUID, std::move(data));
+        return;
     }
 
     SendMessageToSet(&data, true);
@@ -6702,7 +6747,7 @@ void Unit::SendAttackStateUpdate(CalcDamageInfo* damageInfo)
         data << uint32(0);
     }
 
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(data, damageInfo->attacker->GetGUID(), damageInfo->target->GetGUID());
 }
 
 void Unit::SendAttackStateUpdate(uint32 HitInfo, Unit* target, uint8 /*SwingType*/, SpellSchoolMask damageSchoolMask, uint32 Damage, uint32 AbsorbDamage, uint32 Resist, VictimState TargetState, uint32 BlockedAmount)
@@ -11373,9 +11418,12 @@ void Unit::SendHealSpellLog(HealInfo const& healInfo, bool critical)
 
 int32 Unit::HealBySpell(HealInfo& healInfo, bool critical)
 {
-    uint32 heal = healInfo.GetHeal();
-    sScriptMgr->ModifyHealReceived(this, healInfo.GetTarget(), heal, healInfo.GetSpellInfo());
-    healInfo.SetHeal(heal);
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_HEAL_RECEIVED))
+    {
+        uint32 heal = healInfo.GetHeal();
+        sScriptMgr->ModifyHealReceived(this, healInfo.GetTarget(), heal, healInfo.GetSpellInfo());
+        healInfo.SetHeal(heal);
+    }
 
     // calculate heal absorb and reduce healing
     CalcHealAbsorb(healInfo);
@@ -13891,6 +13939,8 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy, uint32 duration)
 
     if (Creature* creature = ToCreature())
     {
+        creature->InvalidateSightReactionRange();
+
         // Set home position at place of engaging combat for escorted creatures
         if ((IsAIEnabled && creature->AI()->IsEscorted()) ||
                 GetMotionMaster()->GetCurrentMovementGeneratorType() == WAYPOINT_MOTION_TYPE ||
@@ -13951,6 +14001,8 @@ void Unit::ClearInCombat()
     // Player's state will be cleared in Player::UpdateContestedPvP
     if (Creature* creature = ToCreature())
     {
+        creature->InvalidateSightReactionRange();
+
         if (creature->GetCreatureTemplate() && creature->GetCreatureTemplate()->unit_flags & UNIT_FLAG_IMMUNE_TO_PC)
             SetImmuneToPC(true); // set immunity state to the one from db on evade
 
@@ -16266,25 +16318,40 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, procPhase, procExtra, procSpell, damageInfo, healInfo, procAura, procAuraEffectIndex);
 
+    // Proc data was reloaded since the index was built
+    if (m_procAuras.GetGeneration() != sSpellMgr->GetProcDataGeneration())
+        RebuildProcAuraIndex();
+
+    // No applied aura can be triggered by this event
+    if (!m_procAuras.HasCandidates(procFlag))
+        return;
+
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
     ProcTriggeredList procTriggered;
     // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+    for (ProcAuraApplicationIndex::const_iterator itr = m_procAuras.begin(); itr != m_procAuras.end(); ++itr)
     {
+        // Skip auras whose proc flags or phases can't match before doing any lookup
+        if (!itr->second.Matches(procFlag, procPhase))
+            continue;
+
+        AuraApplication* aurApp = itr->second.Application;
+
         // Do not allow auras to proc from effect triggered by itself
         if (procAura && procAura->Id == itr->first)
             continue;
 
         // Xinef: Generic Item Equipment cooldown, -1 is a special marker
-        if (itr->second->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
+        if (aurApp->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
             continue;
 
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that have trigger spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -16297,7 +16364,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             active = true;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
         {
             continue;
         }
@@ -16305,7 +16372,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool isTriggeredAtSpellProcEvent = IsTriggeredAtSpellProcEvent(target, triggerData.aura, attType, isVictim, active, triggerData.spellProcEvent, eventInfo);
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(itr->second, eventInfo, isTriggeredAtSpellProcEvent))
+        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(aurApp, eventInfo, isTriggeredAtSpellProcEvent))
         {
             continue;
         }
@@ -16321,9 +16388,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool hasTriggeredProc = false;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
 
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
@@ -17539,6 +17606,42 @@ bool Unit::InitTamedPet(Pet* pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+void Unit::AddProcAuraCandidate(AuraApplication* aurApp)
+{
+    Aura* aura = aurApp->GetBase();
+    SpellInfo const* spellProto = aura->GetSpellInfo();
+
+    ProcAuraApplicationIndex::Candidate candidate;
+    candidate.Application = aurApp;
+    // proc check scripts are called for every event, keep their order and side effects
+    candidate.AlwaysCheck = aura->HasCheckProcScripts();
+
+    // same proc flags and phase as IsTriggeredAtSpellProcEvent / IsSpellProcEventCanTriggeredBy,
+    // auras handled by the new proc system never proc from ProcDamageAndSpellFor
+    if (!sSpellMgr->GetSpellProcEntry(spellProto->Id))
+    {
+        SpellProcEventEntry const* spellProcEvent = sSpellMgr->GetSpellProcEvent(spellProto->Id);
+        candidate.ProcFlags = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellProto->ProcFlags;
+
+        // these flags trigger before the proc phase is checked
+        if (!(candidate.ProcFlags & (PROC_FLAG_KILLED | PROC_FLAG_KILL | PROC_FLAG_DEATH | PROC_FLAG_TAKEN_DAMAGE)))
+            candidate.ProcPhases = spellProcEvent ? spellProcEvent->procPhase : uint32(PROC_SPELL_PHASE_HIT);
+    }
+
+    if (candidate.ProcFlags || candidate.AlwaysCheck)
+        m_procAuras.Insert(spellProto->Id, candidate);
+}
+
+void Unit::RebuildProcAuraIndex()
+{
+    m_procAuras.Clear();
+    m_procAuras.SetGeneration(sSpellMgr->GetProcDataGeneration());
+
+    // m_appliedAuras order is kept, procs are triggered in the same order as before
+    for (AuraApplicationMap::const_iterator itr = m_appliedAuras.begin(); itr != m_appliedAuras.end(); ++itr)
+        AddProcAuraCandidate(itr->second);
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const*& spellProcEvent, ProcEventInfo const& eventInfo)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -26,14 +26,19 @@
 #include "ItemTemplate.h"
 #include "MotionMaster.h"
 #include "Object.h"
+#include "ProcAuraIndex.h"
 #include "SharedDefines.h"
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
 #include "ThreatMgr.h"
 #include "UnitDefines.h"
 #include "UnitUtils.h"
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 #include <functional>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #define WORLD_TRIGGER   12999
 
@@ -759,7 +764,9 @@ public:
     typedef std::list<DiminishingReturn> Diminishing; // 递减返回列表
     typedef GuidUnorderedSet ComboPointHolderSet; // 组合点持有者集合
 
-    typedef std::map<uint8, AuraApplication*> VisibleAuraMap; // 可见Aura映射
+    typedef boost::container::flat_map<uint8, AuraApplication*> VisibleAuraMap; // 可见Aura映射，按槽位连续存储
+    typedef boost::container::small_vector<AuraApplication*, 8> InterruptableAuraList; // 可中断的AuraApplication，少量时不分配内存
+    typedef ProcAuraIndex<AuraApplication> ProcAuraApplicationIndex; // 可能触发的AuraApplication索引
 
     ~Unit() override;
 
@@ -1644,6 +1651,9 @@ public:
     [[nodiscard]] AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
     // 获取指定类型的增益效果列表
 
+    void InvalidateAuraModifierCache(AuraType auratype);
+    // 指定类型的增益效果注册、移除或数值变化后，使该类型的修改值汇总失效
+
     AuraList& GetSingleCastAuras() { return m_scAuras; }
     [[nodiscard]] AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
@@ -2570,6 +2580,7 @@ public:
     void SendPetAIReaction(ObjectGuid guid); // 发送宠物AI反应
 
     void SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo); // 发送周期性增益日志
+    void SendCombatLogMessage(WorldPacket& data, ObjectGuid const& attackerGUID, ObjectGuid const& victimGUID); // 广播战斗日志，开启分发时在地图更新结束后统一发送
 
     void SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log); // 发送非近战法术伤害日志
     void SendSpellNonMeleeReflectLog(SpellNonMeleeDamage* log, Unit* attacker); // 发送反射非近战法术伤害日志
@@ -2705,9 +2716,35 @@ protected:
     uint32 m_removedAurasCount; // 被移除的增益数量
 
     AuraEffectList m_modAuras[TOTAL_AURAS]; // 修改类型的增益效果
+
+    // 一组增益效果修改值的汇总，与逐个遍历 m_modAuras 的计算方式相同
+    struct AuraModifierTotals
+    {
+        int32 Total = 0;            // 修改值之和
+        float Multiplier = 1.0f;    // 按百分比依次相乘的倍率
+        int32 MaxPositive = 0;      // 最大的正向修改值
+        int32 MaxNegative = 0;      // 最小的负向修改值
+
+        void Add(int32 amount);
+        void Add(AuraModifierTotals const& totals);
+    };
+
+    // 每种增益类型的修改值汇总，按需计算，失效后在下次查询时重新计算
+    struct AuraModifierAggregate
+    {
+        bool Valid = false;
+        AuraModifierTotals Totals;
+        int32 AreaExclusive = 0;    // GetTotalAuraModifierAreaExclusive 的结果
+        std::vector<std::pair<int32, AuraModifierTotals>> ByMiscValue; // 按 MiscValue 分组的汇总
+    };
+
+    [[nodiscard]] AuraModifierAggregate const& GetAuraModifierAggregate(AuraType auratype) const;
+    [[nodiscard]] AuraModifierTotals const* GetAuraModifierTotalsByMiscValue(AuraType auratype, int32 misc_value) const;
+    mutable std::unordered_map<uint32, AuraModifierAggregate> m_auraModifierAggregates; // 修改值汇总缓存
     AuraList m_scAuras;                        // 单次施放的增益
-    AuraApplicationList m_interruptableAuras;  // 可中断的增益
+    InterruptableAuraList m_interruptableAuras; // 可中断的增益
     AuraStateAurasMap m_auraStateAuras;        // 用于提升增益状态检查性能
+    ProcAuraApplicationIndex m_procAuras;      // 可能触发的增益，用于提升触发检查性能
     uint32 m_interruptMask; // 中断掩码
 
     float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END]; // 增益修饰符组
@@ -2742,6 +2779,8 @@ protected:
     uint32 m_rootTimes; // 定身次数
 
 private:
+    void AddProcAuraCandidate(AuraApplication* aurApp); // 将可能触发的增益加入触发索引
+    void RebuildProcAuraIndex(); // 触发数据重载后重建触发索引
     bool IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const*& spellProcEvent, ProcEventInfo const& eventInfo); // 判断是否触发法术触发事件
     bool HandleDummyAuraProc(Unit* victim, uint32 damage, AuraEffect* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, ProcEventInfo const& eventInfo); // 处理虚拟增益触发
     bool HandleAuraProc(Unit* victim, uint32 damage, Aura* triggeredByAura, SpellInfo const* procSpell, uint32 procFlag, uint32 procEx, uint32 cooldown, bool* handled); // 处理增益触发
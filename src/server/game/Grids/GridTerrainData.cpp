@@ -3,15 +3,56 @@
 #include "GridTerrainData.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include <algorithm>
 #include <filesystem>
+#include <type_traits>
 #include <G3D/Ray.h>
 
-uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
-uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
-
-GridTerrainData::GridTerrainData()
+namespace
 {
-    _gridGetHeight = &GridTerrainData::getHeightFromFlat;
+    // Reads the V9 and V8 height arrays of the map file and interleaves their rows
+    template<class T>
+    bool LoadHeights(std::ifstream& fileStream, LoadedHeightData& heightData, LoadedHeightData::StorageType storageType)
+    {
+        std::vector<T> v9(LoadedHeightData::V9_ROW_SIZE * LoadedHeightData::V9_ROW_SIZE);
+        std::vector<T> v8(LoadedHeightData::V8_ROW_SIZE * LoadedHeightData::V8_ROW_SIZE);
+        if (!fileStream.read(reinterpret_cast<char*>(v9.data()), v9.size() * sizeof(T))
+            || !fileStream.read(reinterpret_cast<char*>(v8.data()), v8.size() * sizeof(T)))
+            return false;
+
+        heightData.heights = std::make_unique<uint8[]>(LoadedHeightData::VALUE_COUNT * sizeof(T));
+        T* heights = reinterpret_cast<T*>(heightData.heights.get());
+        for (uint32 row = 0; row < LoadedHeightData::V9_ROW_SIZE; ++row)
+        {
+            T* dest = heights + row * LoadedHeightData::ROW_STRIDE;
+            std::copy_n(&v9[row * LoadedHeightData::V9_ROW_SIZE], LoadedHeightData::V9_ROW_SIZE, dest);
+            if (row < LoadedHeightData::V8_ROW_SIZE)
+                std::copy_n(&v8[row * LoadedHeightData::V8_ROW_SIZE], LoadedHeightData::V8_ROW_SIZE, dest + LoadedHeightData::V9_ROW_SIZE);
+        }
+
+        heightData.storageType = storageType;
+        return true;
+    }
+
+    // Height inside of a cell, see getHeightsFromStorage for the layout
+    template<class T>
+    inline float GetCellHeight(T const* v9, float x, float y)
+    {
+        // v9 points to h1, the v8 row follows the v9 row and the next v9 row follows the v8 row
+        float h1 = float(v9[0]);
+        float h2 = float(v9[LoadedHeightData::ROW_STRIDE]);
+        float h3 = float(v9[1]);
+        float h4 = float(v9[LoadedHeightData::ROW_STRIDE + 1]);
+        float h5 = 2 * float(v9[LoadedHeightData::V9_ROW_SIZE]);
+
+        // selects are used instead of branches so the batch loop can be vectorized
+        bool upper = x + y < 1;
+        bool right = x > y;
+        float a = upper ? (right ? h2 - h1 : h5 - h1 - h3) : (right ? h2 + h4 - h5 : h4 - h3);
+        float b = upper ? (right ? h5 - h1 - h2 : h3 - h1) : (right ? h4 - h2 : h3 + h4 - h5);
+        float c = upper ? h1 : h5 - h4;
+        return a * x + b * y + c;
+    }
 }
 
 TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
@@ -87,36 +128,21 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            _loadedHeightData->uint16HeightData = std::make_unique<LoadedHeightData::Uint16HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v9), sizeof(_loadedHeightData->uint16HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v8), sizeof(_loadedHeightData->uint16HeightData->v8)))
+            if (!LoadHeights<uint16>(fileStream, *_loadedHeightData, LoadedHeightData::StorageType::Uint16))
                 return false;
 
-            _loadedHeightData->uint16HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
-            _gridGetHeight = &GridTerrainData::getHeightFromUint16;
+            _loadedHeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            _loadedHeightData->uint8HeightData = std::make_unique<LoadedHeightData::Uint8HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v9), sizeof(_loadedHeightData->uint8HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v8), sizeof(_loadedHeightData->uint8HeightData->v8)))
-                return false;
-
-            _loadedHeightData->uint8HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
-            _gridGetHeight = &GridTerrainData::getHeightFromUint8;
-        }
-        else
-        {
-            _loadedHeightData->floatHeightData = std::make_unique<LoadedHeightData::FloatHeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v9), sizeof(_loadedHeightData->floatHeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v8), sizeof(_loadedHeightData->floatHeightData->v8)))
+            if (!LoadHeights<uint8>(fileStream, *_loadedHeightData, LoadedHeightData::StorageType::Uint8))
                 return false;
 
-            _gridGetHeight = &GridTerrainData::getHeightFromFloat;
+            _loadedHeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
         }
+        else if (!LoadHeights<float>(fileStream, *_loadedHeightData, LoadedHeightData::StorageType::Float))
+            return false;
     }
-    else
-        _gridGetHeight = &GridTerrainData::getHeightFromFlat;
 
     if (header.flags & MAP_HEIGHT_HAS_FLIGHT_BOUNDS)
     {
@@ -192,10 +218,26 @@ bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const off
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _loadedLiquidData->liquidMap = std::make_unique<LoadedLiquidData::LiquidMapType>();
-        _loadedLiquidData->liquidMap->resize(_loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidMap->data()), _loadedLiquidData->liquidMap->size() * sizeof(float)))
+        std::vector<float> liquidHeights(_loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
+        if (!fileStream.read(reinterpret_cast<char*>(liquidHeights.data()), liquidHeights.size() * sizeof(float)))
             return false;
+
+        _loadedLiquidData->liquidMap = std::make_unique<LoadedLiquidData::LiquidMapType>();
+
+        std::vector<float> levels = liquidHeights;
+        std::sort(levels.begin(), levels.end());
+        levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+        if (levels.size() <= 256)
+        {
+            // few distinct levels (lakes, sea), store one byte per point
+            _loadedLiquidData->liquidMap->indices.reserve(liquidHeights.size());
+            for (float height : liquidHeights)
+                _loadedLiquidData->liquidMap->indices.push_back(uint8(std::lower_bound(levels.begin(), levels.end(), height) - levels.begin()));
+
+            _loadedLiquidData->liquidMap->levels = std::move(levels);
+        }
+        else
+            _loadedLiquidData->liquidMap->levels = std::move(liquidHeights);
     }
     return true;
 }
@@ -204,10 +246,23 @@ bool GridTerrainData::LoadHolesData(std::ifstream& fileStream, uint32 const offs
 {
     fileStream.seekg(offset);
 
-    _loadedHoleData = std::make_unique<LoadedHoleData>();
-    if (!fileStream.read(reinterpret_cast<char*>(&_loadedHoleData->holes), sizeof(_loadedHoleData->holes)))
+    // 16x16 cells with 4x4 hole bits each
+    std::array<uint16, 16 * 16> cellHoles;
+    if (!fileStream.read(reinterpret_cast<char*>(cellHoles.data()), sizeof(cellHoles)))
         return false;
 
+    if (std::all_of(cellHoles.begin(), cellHoles.end(), [](uint16 hole) { return hole == 0; }))
+        return true;
+
+    // bit 4 * row + col of a cell is the hole at (cellRow * 4 + row, cellCol * 4 + col)
+    _loadedHoleData = std::make_unique<LoadedHoleData>();
+    _loadedHoleData->holes.fill(0);
+    for (uint32 cellRow = 0; cellRow < 16; ++cellRow)
+        for (uint32 cellCol = 0; cellCol < 16; ++cellCol)
+            for (uint32 bit = 0; bit < 16; ++bit)
+                if (cellHoles[cellRow * 16 + cellCol] & (1 << bit))
+                    _loadedHoleData->holes[cellRow * 4 + bit / 4] |= uint64(1) << (cellCol * 4 + bit % 4);
+
     return true;
 }
 
@@ -226,32 +281,41 @@ uint16 GridTerrainData::getArea(float x, float y) const
     return _loadedAreaData->areaMap->at(lx * 16 + ly);
 }
 
-float GridTerrainData::getHeightFromFlat(float /*x*/, float /*y*/) const
+float GridTerrainData::getHeight(float x, float y) const
 {
-    if (!_loadedHeightData)
-        return INVALID_HEIGHT;
-
-    return _loadedHeightData->gridHeight;
+    float height;
+    getHeights(&x, &y, &height, 1);
+    return height;
 }
 
-float GridTerrainData::getHeightFromFloat(float x, float y) const
+void GridTerrainData::getHeights(float const* xs, float const* ys, float* heights, uint32 count) const
 {
-    if (!_loadedHeightData || !_loadedHeightData->floatHeightData)
-        return INVALID_HEIGHT;
-
-    x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y / SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
+    if (!_loadedHeightData)
+    {
+        std::fill_n(heights, count, INVALID_HEIGHT);
+        return;
+    }
 
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
+    switch (_loadedHeightData->storageType)
+    {
+        case LoadedHeightData::StorageType::Uint8:
+            getHeightsFromStorage<uint8>(xs, ys, heights, count);
+            break;
+        case LoadedHeightData::StorageType::Uint16:
+            getHeightsFromStorage<uint16>(xs, ys, heights, count);
+            break;
+        case LoadedHeightData::StorageType::Float:
+            getHeightsFromStorage<float>(xs, ys, heights, count);
+            break;
+        default:
+            std::fill_n(heights, count, _loadedHeightData->gridHeight);
+            break;
+    }
+}
 
+template<class T>
+void GridTerrainData::getHeightsFromStorage(float const* xs, float const* ys, float* heights, uint32 count) const
+{
     // Height stored as: h5 - its v8 grid, h1-h4 - its v9 grid
     // +--------------> X
     // | h1-------h2     Coordinates is:
@@ -266,212 +330,32 @@ float GridTerrainData::getHeightFromFloat(float x, float y) const
     // 1 - detect triangle
     // 2 - solve linear equation from triangle points
     // Calculate coefficients for solve h = a*x + b*y + c
+    T const* storage = _loadedHeightData->GetHeights<T>();
+    uint64 const* holes = _loadedHoleData ? _loadedHoleData->holes.data() : nullptr;
 
-    float a, b, c;
-    // Select triangle:
-    if (x + y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            float h1 = _loadedHeightData->floatHeightData->v9[(x_int) * 129 + y_int];
-            float h2 = _loadedHeightData->floatHeightData->v9[(x_int + 1) * 129 + y_int];
-            float h5 = 2 * _loadedHeightData->floatHeightData->v8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            float h1 = _loadedHeightData->floatHeightData->v9[x_int * 129 + y_int];
-            float h3 = _loadedHeightData->floatHeightData->v9[x_int * 129 + y_int + 1];
-            float h5 = 2 * _loadedHeightData->floatHeightData->v8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            float h2 = _loadedHeightData->floatHeightData->v9[(x_int + 1) * 129 + y_int];
-            float h4 = _loadedHeightData->floatHeightData->v9[(x_int + 1) * 129 + y_int + 1];
-            float h5 = 2 * _loadedHeightData->floatHeightData->v8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            float h3 = _loadedHeightData->floatHeightData->v9[(x_int) * 129 + y_int + 1];
-            float h4 = _loadedHeightData->floatHeightData->v9[(x_int + 1) * 129 + y_int + 1];
-            float h5 = 2 * _loadedHeightData->floatHeightData->v8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return a * x + b * y + c;
-}
-
-float GridTerrainData::getHeightFromUint8(float x, float y) const
-{
-    if (!_loadedHeightData || !_loadedHeightData->uint8HeightData)
-        return INVALID_HEIGHT;
-
-    x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y / SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
-
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint8* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
-    if (x + y < 1)
-    {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * _loadedHeightData->uint8HeightData->v8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * _loadedHeightData->uint8HeightData->v8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
-    }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * _loadedHeightData->uint8HeightData->v8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * _loadedHeightData->uint8HeightData->v8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c) * _loadedHeightData->uint8HeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
-}
+    float const multiplier = _loadedHeightData->gridIntHeightMultiplier;
+    float const gridHeight = _loadedHeightData->gridHeight;
 
-float GridTerrainData::getHeightFromUint16(float x, float y) const
-{
-    if (!_loadedHeightData || !_loadedHeightData->uint16HeightData)
-        return INVALID_HEIGHT;
-
-    x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
-    y = MAP_RESOLUTION * (32 - y / SIZE_OF_GRIDS);
-
-    int x_int = (int)x;
-    int y_int = (int)y;
-    x -= x_int;
-    y -= y_int;
-    x_int &= (MAP_RESOLUTION - 1);
-    y_int &= (MAP_RESOLUTION - 1);
-
-    if (isHole(x_int, y_int))
-        return INVALID_HEIGHT;
-
-    int32 a, b, c;
-    uint16* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
-    if (x + y < 1)
+    for (uint32 i = 0; i < count; ++i)
     {
-        if (x > y)
-        {
-            // 1 triangle (h1, h2, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h2 = V9_h1_ptr[129];
-            int32 h5 = 2 * _loadedHeightData->uint16HeightData->v8[x_int * 128 + y_int];
-            a = h2 - h1;
-            b = h5 - h1 - h2;
-            c = h1;
-        }
-        else
-        {
-            // 2 triangle (h1, h3, h5 points)
-            int32 h1 = V9_h1_ptr[0];
-            int32 h3 = V9_h1_ptr[1];
-            int32 h5 = 2 * _loadedHeightData->uint16HeightData->v8[x_int * 128 + y_int];
-            a = h5 - h1 - h3;
-            b = h3 - h1;
-            c = h1;
-        }
+        float x = MAP_RESOLUTION * (32 - xs[i] / SIZE_OF_GRIDS);
+        float y = MAP_RESOLUTION * (32 - ys[i] / SIZE_OF_GRIDS);
+
+        int x_int = (int)x;
+        int y_int = (int)y;
+        x -= x_int;
+        y -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        float height = GetCellHeight(storage + x_int * LoadedHeightData::ROW_STRIDE + y_int, x, y);
+        // integer heights are scaled back into the grid height range
+        if constexpr (!std::is_floating_point_v<T>)
+            height = height * multiplier + gridHeight;
+
+        bool hole = holes && ((holes[x_int >> 1] >> (y_int >> 1)) & 1);
+        heights[i] = hole ? INVALID_HEIGHT : height;
     }
-    else
-    {
-        if (x > y)
-        {
-            // 3 triangle (h2, h4, h5 points)
-            int32 h2 = V9_h1_ptr[129];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * _loadedHeightData->uint16HeightData->v8[x_int * 128 + y_int];
-            a = h2 + h4 - h5;
-            b = h4 - h2;
-            c = h5 - h4;
-        }
-        else
-        {
-            // 4 triangle (h3, h4, h5 points)
-            int32 h3 = V9_h1_ptr[1];
-            int32 h4 = V9_h1_ptr[130];
-            int32 h5 = 2 * _loadedHeightData->uint16HeightData->v8[x_int * 128 + y_int];
-            a = h4 - h3;
-            b = h3 + h4 - h5;
-            c = h5 - h4;
-        }
-    }
-    // Calculate height
-    return (float)((a * x) + (b * y) + c) * _loadedHeightData->uint16HeightData->gridIntHeightMultiplier + _loadedHeightData->gridHeight;
-}
-
-bool GridTerrainData::isHole(int row, int col) const
-{
-    if (!_loadedHoleData)
-        return false;
-
-    int cellRow = row / 8; // 8 squares per cell
-    int cellCol = col / 8;
-    int holeRow = row % 8 / 2;
-    int holeCol = (col - (cellCol * 8)) / 2;
-
-    uint16 hole = _loadedHoleData->holes[cellRow * 16 + cellCol];
-
-    return (hole & holetab_h[holeCol] & holetab_v[holeRow]) != 0;
 }
 
 float GridTerrainData::getMinHeight(float x, float y) const
@@ -19,9 +19,11 @@
 #define GRID_TERRAIN_DATA_H
 
 #include "Common.h"
+#include <array>
 #include <fstream>
 #include <G3D/Plane.h>
 #include <memory>
+#include <vector>
 
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
@@ -146,49 +148,30 @@ struct LoadedHeightData
     // 高度平面数据类型，使用包含8个G3D::Plane的数组
     typedef std::array<G3D::Plane, 8> HeightPlanesType;
 
-    // 16位无符号整数高度数据结构体
-    struct Uint16HeightData
+    // 高度数据的存储格式，与地图文件中的格式一致
+    enum class StorageType : uint8
     {
-        // 版本9的高度数据类型，使用129x129的无符号16位整数数组
-        typedef std::array<uint16, 129 * 129> V9Type;
-        // 版本8的高度数据类型，使用128x128的无符号16位整数数组
-        typedef std::array<uint16, 128 * 128> V8Type;
-
-        V9Type v9;                     // 版本9的高度数据
-        V8Type v8;                     // 版本8的高度数据
-        float gridIntHeightMultiplier; // 网格整数高度乘数
+        Flat,   // 整个网格高度相同，只有 gridHeight
+        Uint8,  // 8位无符号整数，乘以 gridIntHeightMultiplier 后加上 gridHeight
+        Uint16, // 16位无符号整数，乘以 gridIntHeightMultiplier 后加上 gridHeight
+        Float   // 浮点数
     };
 
-    // 8位无符号整数高度数据结构体
-    struct Uint8HeightData
-    {
-        // 版本9的高度数据类型，使用129x129的无符号8位整数数组
-        typedef std::array<uint8, 129 * 129> V9Type;
-        // 版本8的高度数据类型，使用128x128的无符号8位整数数组
-        typedef std::array<uint8, 128 * 128> V8Type;
-
-        V9Type v9;                     // 版本9的高度数据
-        V8Type v8;                     // 版本8的高度数据
-        float gridIntHeightMultiplier; // 网格整数高度乘数
-    };
-
-    // 浮点数高度数据结构体
-    struct FloatHeightData
-    {
-        // 版本9的高度数据类型，使用129x129的浮点数数组
-        typedef std::array<float, 129 * 129> V9Type;
-        // 版本8的高度数据类型，使用128x128的浮点数数组
-        typedef std::array<float, 128 * 128> V8Type;
-
-        V9Type v9; // 版本9的高度数据
-        V8Type v8; // 版本8的高度数据
-    };
+    // V9 和 V8 高度按行交错存储在同一块内存中：第 x 行的 129 个 V9 高度后紧跟第 x 行的 128 个 V8 高度，
+    // 查询一个单元格所需的 V9 第 x、x+1 行和 V8 第 x 行在内存中是相邻的
+    static constexpr uint32 V9_ROW_SIZE = 129;
+    static constexpr uint32 V8_ROW_SIZE = 128;
+    static constexpr uint32 ROW_STRIDE = V9_ROW_SIZE + V8_ROW_SIZE;
+    static constexpr uint32 VALUE_COUNT = ROW_STRIDE * 128 + V9_ROW_SIZE;
 
+    StorageType storageType{ StorageType::Flat }; // 存储格式
     float gridHeight;                     // 网格高度
-    std::unique_ptr<Uint16HeightData> uint16HeightData; // 指向16位无符号整数高度数据的智能指针
-    std::unique_ptr<Uint8HeightData> uint8HeightData;   // 指向8位无符号整数高度数据的智能指针
-    std::unique_ptr<FloatHeightData> floatHeightData;   // 指向浮点数高度数据的智能指针
+    float gridIntHeightMultiplier{ 1.0f }; // 网格整数高度乘数
+    std::unique_ptr<uint8[]> heights;     // VALUE_COUNT 个 storageType 格式的高度值
     std::unique_ptr<HeightPlanesType> minHeightPlanes;  // 指向最小高度平面数据的智能指针
+
+    template<class T>
+    [[nodiscard]] T const* GetHeights() const { return reinterpret_cast<T const*>(heights.get()); }
 };
 
 // 已加载的液体数据结构体
@@ -198,8 +181,16 @@ struct LoadedLiquidData
     typedef std::array<uint16, 16 * 16> LiquidEntryType;
     // 液体标志数据类型，使用16x16的无符号8位整数数组
     typedef std::array<uint8, 16 * 16> LiquidFlagsType;
-    // 液体地图数据类型，使用浮点数向量
-    typedef std::vector<float> LiquidMapType;
+
+    // 液体高度数据，大部分网格中只有少量不同的液面高度，
+    // 不超过 256 种时按调色板存储每个点的索引，否则存储完整的浮点数
+    struct LiquidMapType
+    {
+        std::vector<float> levels;   // 不同的液面高度，或每个点的高度
+        std::vector<uint8> indices;  // 每个点在 levels 中的索引，为空时 levels 即每个点的高度
+
+        [[nodiscard]] float at(uint32 index) const { return indices.empty() ? levels.at(index) : levels[indices.at(index)]; }
+    };
 
     uint16 liquidGlobalEntry;   // 全局液体条目
     uint8 liquidGlobalFlags;    // 全局液体标志
@@ -216,8 +207,8 @@ struct LoadedLiquidData
 // 已加载的空洞数据结构体
 struct LoadedHoleData
 {
-    // 空洞数据类型，使用16x16的无符号16位整数数组
-    typedef std::array<uint16, 16 * 16> HolesType;
+    // 空洞数据类型，64x64 位图，每一位对应 2x2 个高度单元格
+    typedef std::array<uint64, 64> HolesType;
 
     HolesType holes; // 空洞数据
 };
@@ -274,24 +265,12 @@ class GridTerrainData
     std::unique_ptr<LoadedLiquidData> _loadedLiquidData; // 指向已加载液体数据的智能指针
     std::unique_ptr<LoadedHoleData> _loadedHoleData;     // 指向已加载空洞数据的智能指针
 
-    // 判断指定位置是否为空洞
-    bool isHole(int row, int col) const;
-
-    // 获取高度函数指针类型
-    typedef float (GridTerrainData::* GetHeightPtr) (float x, float y) const;
-    GetHeightPtr _gridGetHeight; // 高度获取函数指针
-
-    // 从浮点数数据获取高度
-    float getHeightFromFloat(float x, float y) const;
-    // 从16位无符号整数数据获取高度
-    float getHeightFromUint16(float x, float y) const;
-    // 从8位无符号整数数据获取高度
-    float getHeightFromUint8(float x, float y) const;
-    // 从平面数据获取高度
-    float getHeightFromFlat(float x, float y) const;
+    // 按存储格式批量计算高度
+    template<class T>
+    void getHeightsFromStorage(float const* xs, float const* ys, float* heights, uint32 count) const;
 
 public:
-    GridTerrainData(); // 构造函数
+    GridTerrainData() = default; // 构造函数
     ~GridTerrainData() { }; // 析构函数
     // 加载地图文件
     TerrainMapDataReadResult Load(std::string const& mapFileName);
@@ -299,7 +278,9 @@ public:
     // 获取指定位置的区域ID
     uint16 getArea(float x, float y) const;
     // 获取指定位置的高度
-    inline float getHeight(float x, float y) const { return (this->*_gridGetHeight)(x, y); }
+    float getHeight(float x, float y) const;
+    // 批量获取高度，所有点必须位于这个网格内，结果与逐个调用 getHeight 相同
+    void getHeights(float const* xs, float const* ys, float* heights, uint32 count) const;
     // 获取指定位置的最小高度
     float getMinHeight(float x, float y) const;
     // 获取指定位置的液体高度
@@ -152,7 +152,8 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
         return;
     }
 
-    if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
+    // most creatures around a moving unit are out of their aggro range, friendly or busy, skip them before the visibility checks
+    if (!c->HasUnitState(UNIT_STATE_SIGHTLESS) && c->IsInSightReactionRange(u))
     {
         if (c->IsAIEnabled && c->CanSeeOrDetect(u, false, true))
         {
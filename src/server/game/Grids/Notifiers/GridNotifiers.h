@@ -100,17 +100,31 @@ namespace Acore
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::size_t i_messageCount;
+        std::vector<Player*>* i_receivers;
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
         Player const* skipped_receiver;
         bool required3dDist;
         MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = nullptr, bool req3dDist = false)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_message(msg), i_messageCount(1), i_receivers(nullptr), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , teamId((own_team_only && src->IsPlayer()) ? src->ToPlayer()->GetTeamId() : TEAM_NEUTRAL)
             , skipped_receiver(skipped), required3dDist(req3dDist)
         {
         }
+        // several packets about the same source delivered in one visit
+        MessageDistDeliverer(WorldObject const* src, std::vector<WorldPacket> const& msgs, float dist)
+            : i_source(src), i_message(msgs.data()), i_messageCount(msgs.size()), i_receivers(nullptr), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            , teamId(TEAM_NEUTRAL), skipped_receiver(nullptr), required3dDist(false)
+        {
+        }
+        // only collects the players that would receive a message about the source, the caller sends itself
+        MessageDistDeliverer(WorldObject const* src, std::vector<Player*>& receivers, float dist)
+            : i_source(src), i_message(nullptr), i_messageCount(0), i_receivers(&receivers), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            , teamId(TEAM_NEUTRAL), skipped_receiver(nullptr), required3dDist(false)
+        {
+        }
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
         void Visit(DynamicObjectMapType& m);
@@ -125,7 +139,14 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            if (i_receivers)
+            {
+                i_receivers->push_back(player);
+                return;
+            }
+
+            for (std::size_t i = 0; i < i_messageCount; ++i)
+                player->GetSession()->SendPacket(&i_message[i]);
         }
     };
 
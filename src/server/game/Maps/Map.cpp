@@ -32,7 +32,6 @@
 #include "MapInstanced.h"
 #include "Metric.h"
 #include "MiscPackets.h"
-#include "MMapFactory.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -67,8 +66,6 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
@@ -555,10 +552,15 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     if (!t_diff)
     {
+        _periodicAuraLogQueue.Flush(this);
+        _combatLogDispatcher.Flush(this);
         HandleDelayedVisibility();
         return;
     }
 
+    // 计算上一次更新中排队的异步寻路请求
+    _pathfinder.Update();
+
     _updatableObjectListRecheckTimer.Update(t_diff);
     resetMarkedCells();
 
@@ -589,6 +591,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     if (_updatableObjectListRecheckTimer.Passed())
     {
+        // objects away from these cells are updated at the reduced rate
+        _playerMarkedCells = marked_cells;
+
         // Mark all cells near active objects
         for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end(); ++m_activeNonPlayersIter)
         {
@@ -602,6 +607,10 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     UpdateNonPlayerObjects(t_diff);
 
+    // 发送本次更新中所有周期效果跳数的战斗日志，周期日志开启分发时会再进入分发器
+    _periodicAuraLogQueue.Flush(this);
+    _combatLogDispatcher.Flush(this);
+
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -631,8 +640,10 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
 void Map::UpdateNonPlayerObjects(uint32 const diff)
 {
+    uint32 const reducedRateInterval = sWorld->getIntConfig(CONFIG_INTERVAL_MAPUPDATE_REDUCED_RATE);
+
     for (WorldObject* obj : _pendingAddUpdatableObjectList)
-        _AddObjectToUpdateList(obj);
+        _AddObjectToUpdateList(obj, diff);
     _pendingAddUpdatableObjectList.clear();
 
     if (_updatableObjectListRecheckTimer.Passed())
@@ -646,10 +657,19 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
                 continue;
             }
 
-            obj->Update(diff);
+            // every object catches up on the recheck, the rate is decided again for the next interval
+            UpdatableObjectRate& rate = _updatableObjectRates[i];
+            uint32 updateDiff = diff + rate.SkippedDiff;
+            rate.SkippedDiff = 0;
+            rate.Reduced = reducedRateInterval && _IsReducedRateObject(obj);
+
+            obj->Update(updateDiff);
 
             if (!obj->IsUpdateNeeded())
             {
+                if (reducedRateInterval)
+                    dynamic_cast<UpdatableMapObject*>(obj)->SetMapUpdateSuspendTime(GameTime::GetGameTimeMS());
+
                 _RemoveObjectFromUpdateList(obj);
                 // Intentional no iteration here, obj is swapped with last element in
                 // _updatableObjectList so next loop will update that object at the same index
@@ -667,17 +687,58 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
             if (!obj->IsInWorld())
                 continue;
 
-            obj->Update(diff);
+            UpdatableObjectRate& rate = _updatableObjectRates[i];
+            uint32 updateDiff = diff + rate.SkippedDiff;
+            if (rate.Reduced && updateDiff < reducedRateInterval)
+            {
+                // combat and evade are never delayed
+                Creature* creature = obj->ToCreature();
+                if (!creature || (!creature->IsInCombat() && !creature->HasUnitState(UNIT_STATE_EVADE)))
+                {
+                    rate.SkippedDiff = updateDiff;
+                    continue;
+                }
+            }
+
+            rate.SkippedDiff = 0;
+            obj->Update(updateDiff);
         }
     }
 }
 
+bool Map::_IsReducedRateObject(WorldObject* obj) const
+{
+    if (obj->isActiveObject())
+        return false;
+
+    if (Creature* creature = obj->ToCreature())
+    {
+        if (creature->IsVisibilityOverridden())
+            return false;
+    }
+    else if (GameObject* go = obj->ToGameObject())
+    {
+        if (go->IsTransport())
+            return false;
+    }
+
+    CellCoord cellCoord = Acore::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY());
+    return !_playerMarkedCells.test(cellCoord.GetId());
+}
+
 void Map::AddObjectToPendingUpdateList(WorldObject* obj)
 {
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
+    {
+        // a player sees the object, it is updated at full rate until the next recheck
+        _updatableObjectRates[mapUpdatableObject->GetMapUpdateListOffset()].Reduced = false;
+        return;
+    }
+
     if (mapUpdatableObject->GetUpdateState() != UpdatableMapObject::UpdateState::NotUpdating)
         return;
 
@@ -686,14 +747,26 @@ void Map::AddObjectToPendingUpdateList(WorldObject* obj)
 }
 
 // Internal use only
-void Map::_AddObjectToUpdateList(WorldObject* obj)
+void Map::_AddObjectToUpdateList(WorldObject* obj, uint32 diff)
 {
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     ASSERT(mapUpdatableObject && mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd);
 
+    // the time the object was suspended is passed on with its first update, that update brings its own diff
+    uint32 skippedDiff = 0;
+    if (mapUpdatableObject->GetMapUpdateSuspendTime() != Milliseconds::zero())
+    {
+        Milliseconds suspended = GameTime::GetGameTimeMS() - mapUpdatableObject->GetMapUpdateSuspendTime();
+        if (suspended > Milliseconds(diff))
+            skippedDiff = uint32(std::min<int64>(suspended.count() - diff, MAP_UPDATE_MAX_CATCH_UP));
+
+        mapUpdatableObject->SetMapUpdateSuspendTime(Milliseconds::zero());
+    }
+
     mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::Updating);
     mapUpdatableObject->SetMapUpdateListOffset(_updatableObjectList.size());
     _updatableObjectList.push_back(obj);
+    _updatableObjectRates.push_back({ skippedDiff, false });
 }
 
 // Internal use only
@@ -704,11 +777,14 @@ void Map::_RemoveObjectFromUpdateList(WorldObject* obj)
 
     if (obj != _updatableObjectList.back())
     {
-        dynamic_cast<UpdatableMapObject*>(_updatableObjectList.back())->SetMapUpdateListOffset(mapUpdatableObject->GetMapUpdateListOffset());
-        std::swap(_updatableObjectList[mapUpdatableObject->GetMapUpdateListOffset()], _updatableObjectList.back());
+        std::size_t offset = mapUpdatableObject->GetMapUpdateListOffset();
+        dynamic_cast<UpdatableMapObject*>(_updatableObjectList.back())->SetMapUpdateListOffset(offset);
+        std::swap(_updatableObjectList[offset], _updatableObjectList.back());
+        std::swap(_updatableObjectRates[offset], _updatableObjectRates.back());
     }
 
     _updatableObjectList.pop_back();
+    _updatableObjectRates.pop_back();
     mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::NotUpdating);
 }
 
@@ -718,6 +794,9 @@ void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
         return;
 
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    // an object leaving the world does not catch up on the time it spent outside the update list
+    mapUpdatableObject->SetMapUpdateSuspendTime(Milliseconds::zero());
+
     if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd)
         _pendingAddUpdatableObjectList.erase(obj);
     else if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
@@ -1195,10 +1274,14 @@ Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, Worl
 }
 
 float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    return GetHeightWithGridHeight(GetGridHeight(x, y), x, y, z, checkVMap, maxSearchDist);
+}
+
+float Map::GetHeightWithGridHeight(float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist) const
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    float gridHeight = GetGridHeight(x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
@@ -1239,6 +1322,45 @@ float Map::GetGridHeight(float x, float y) const
     return INVALID_HEIGHT;
 }
 
+void Map::GetGridHeights(float const* xs, float const* ys, float* heights, uint32 count) const
+{
+    // consecutive points in the same grid are sampled together
+    for (uint32 first = 0; first < count;)
+    {
+        GridCoord const gridCoord = Acore::ComputeGridCoord(xs[first], ys[first]);
+        uint32 last = first + 1;
+        while (last < count && Acore::ComputeGridCoord(xs[last], ys[last]) == gridCoord)
+            ++last;
+
+        if (GridTerrainData* gmap = const_cast<Map*>(this)->GetGridTerrainData(gridCoord))
+            gmap->getHeights(xs + first, ys + first, heights + first, last - first);
+        else
+            std::fill(heights + first, heights + last, INVALID_HEIGHT);
+
+        first = last;
+    }
+}
+
+std::vector<WorldObject*> Map::AcquireTargetSearchBuffer()
+{
+    if (_targetSearchBuffers.empty())
+        return {};
+
+    std::vector<WorldObject*> buffer = std::move(_targetSearchBuffers.back());
+    _targetSearchBuffers.pop_back();
+    return buffer;
+}
+
+void Map::ReleaseTargetSearchBuffer(std::vector<WorldObject*>&& buffer)
+{
+    // keep a few buffers around, nested searches are rare
+    if (_targetSearchBuffers.size() >= 4)
+        return;
+
+    buffer.clear();
+    _targetSearchBuffers.push_back(std::move(buffer));
+}
+
 float Map::GetMinHeight(float x, float y) const
 {
     if (GridTerrainData const* grid = const_cast<Map*>(this)->GetGridTerrainData(x, y))
@@ -1654,6 +1776,14 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=tr
     return std::max<float>(h1, h2);
 }
 
+float Map::GetHeightWithGridHeight(uint32 phasemask, float gridHeight, float x, float y, float z, bool vmap, float maxSearchDist) const
+{
+    float h1, h2;
+    h1 = GetHeightWithGridHeight(gridHeight, x, y, z, vmap, maxSearchDist);
+    h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
+    return std::max<float>(h1, h2);
+}
+
 bool Map::IsInWater(uint32 phaseMask, float x, float y, float pZ, float collisionHeight) const
 {
     LiquidData const& liquidData = const_cast<Map*>(this)->GetLiquidData(phaseMask, x, y, pZ, collisionHeight, MAP_ALL_LIQUIDS);
@@ -19,6 +19,7 @@
 #define ACORE_MAP_H
 
 #include "Cell.h"
+#include "CombatLogDispatcher.h"
 #include "DBCStructure.h"
 #include "DataMap.h"
 #include "Define.h"
@@ -27,10 +28,12 @@
 #include "GridDefines.h"
 #include "GridRefMgr.h"
 #include "MapGridManager.h"
+#include "MapPathfinder.h"
 #include "MapRefMgr.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
+#include "PeriodicAuraLogQueue.h"
 #include "Position.h"
 #include "SharedDefines.h"
 #include "TaskScheduler.h"
@@ -87,6 +90,7 @@ struct ScriptAction
 #define DEFAULT_HEIGHT_SEARCH 50.0f                              // default search distance to find height at nearby locations
 #define MIN_UNLOAD_DELAY 1                                       // immediate unload
 #define UPDATABLE_OBJECT_LIST_RECHECK_TIMER 30 * IN_MILLISECONDS // Time to recheck update object list
+#define MAP_UPDATE_MAX_CATCH_UP HOUR * IN_MILLISECONDS           // Longest suspended time passed on to an object returning to the update list
 
 struct PositionFullTerrainStatus
 {
@@ -409,6 +413,13 @@ public:
      */
     [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
 
+    /**
+     * 使用已经取得的网格高度获取指定坐标的高度，与 GetHeight 相同但不再查询网格高度
+     * @param gridHeight GetGridHeight 或 GetGridHeights 返回的网格高度
+     * @return 返回高度值，如果找不到则返回INVALID_HEIGHT
+     */
+    [[nodiscard]] float GetHeightWithGridHeight(float gridHeight, float x, float y, float z, bool checkVMap, float maxSearchDist) const;
+
     /**
      * 获取网格高度
      * @param x X坐标
@@ -417,6 +428,15 @@ public:
      */
     [[nodiscard]] float GetGridHeight(float x, float y) const;
 
+    /**
+     * 批量获取网格高度，同一网格中的连续点一起计算
+     * @param xs X坐标数组
+     * @param ys Y坐标数组
+     * @param heights 输出的网格高度数组
+     * @param count 点的数量
+     */
+    void GetGridHeights(float const* xs, float const* ys, float* heights, uint32 count) const;
+
     /**
      * 获取最小高度
      * @param x X坐标
@@ -1046,6 +1066,12 @@ public:
      * @return 返回指定位置的高度，如果未找到则返回INVALID_HEIGHT
      */
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+    /**
+     * 使用已经取得的网格高度获取指定位置的高度，包括动态物体
+     * @param gridHeight GetGridHeight 或 GetGridHeights 返回的网格高度
+     * @return 返回指定位置的高度，如果未找到则返回INVALID_HEIGHT
+     */
+    [[nodiscard]] float GetHeightWithGridHeight(uint32 phasemask, float gridHeight, float x, float y, float z, bool vmap, float maxSearchDist) const;
     /**
      * 检查两点之间是否有视线
      * @param x1 起点X坐标
@@ -1135,6 +1161,32 @@ public:
      * @return 返回动态地图树的常量引用
      */
     [[nodiscard]] DynamicMapTree const &GetDynamicMapTree() const { return _dynamicTree; }
+    /**
+     * 获取地图的异步寻路队列
+     * @return 返回异步寻路队列的引用
+     */
+    MapPathfinder& GetPathfinder() { return _pathfinder; }
+    /**
+     * 获取地图的周期性光环日志队列，队列中的日志在单位更新结束后统一发送
+     * @return 返回周期性光环日志队列的引用
+     */
+    PeriodicAuraLogQueue& GetPeriodicAuraLogQueue() { return _periodicAuraLogQueue; }
+    /**
+     * 获取地图的战斗日志分发器，排队的战斗日志在单位更新结束后按观察者统一发送
+     * @return 返回战斗日志分发器的引用
+     */
+    CombatLogDispatcher& GetCombatLogDispatcher() { return _combatLogDispatcher; }
+    /**
+     * 取出一个法术目标搜索用的临时容器，容器为空但保留之前分配的内存
+     * 可嵌套调用，每次调用都会得到不同的容器
+     * @return 返回临时容器
+     */
+    std::vector<WorldObject*> AcquireTargetSearchBuffer();
+    /**
+     * 归还 AcquireTargetSearchBuffer 取出的临时容器，供之后的搜索复用
+     * @param buffer 临时容器
+     */
+    void ReleaseTargetSearchBuffer(std::vector<WorldObject*>&& buffer);
     /**
      * 获取对象碰撞位置
      * @param phasemask 相位掩码
@@ -1474,6 +1526,14 @@ public:
     // 待添加的可更新对象列表类型定义，使用无序集合存储世界对象指针
     typedef std::unordered_set<WorldObject *> PendingAddUpdatableObjectList;
 
+    // 可更新对象的更新频率状态，与 _updatableObjectList 按下标一一对应
+    struct UpdatableObjectRate
+    {
+        uint32 SkippedDiff;     // 降频或暂停期间尚未补上的更新时间
+        bool Reduced;           // 远离玩家，按 MapUpdate.ReducedRateInterval 更新
+    };
+    typedef std::vector<UpdatableObjectRate> UpdatableObjectRateList;
+
 private:
     /**
      * 初始化对象
@@ -1574,6 +1634,14 @@ protected:
     float m_VisibleDistance;
     // 动态地图树
     DynamicMapTree _dynamicTree;
+    // 异步寻路队列
+    MapPathfinder _pathfinder;
+    // 周期性光环日志队列
+    PeriodicAuraLogQueue _periodicAuraLogQueue;
+    // 战斗日志分发器
+    CombatLogDispatcher _combatLogDispatcher;
+    // 空闲的法术目标搜索临时容器
+    std::vector<std::vector<WorldObject*>> _targetSearchBuffers;
     // 实例重置周期
     time_t _instanceResetPeriod; // pussywizard
 
@@ -1728,8 +1796,14 @@ private:
     /**
      * 将对象添加到更新列表中
      * @param obj 世界对象指针
+     * @param diff 本次地图更新的时间差(毫秒)，用于计算暂停期间需要补上的时间
+     */
+    void _AddObjectToUpdateList(WorldObject *obj, uint32 diff);
+    /**
+     * 检查对象是否远离玩家，可以降低更新频率，在更新列表重新检查时调用
+     * @param obj 世界对象指针
      */
-    void _AddObjectToUpdateList(WorldObject *obj);
+    bool _IsReducedRateObject(WorldObject *obj) const;
     /**
      * 从更新列表中移除对象
      * @param obj 世界对象指针
@@ -1784,6 +1858,10 @@ private:
 
     // 可更新对象列表
     UpdatableObjectList _updatableObjectList;
+    // 可更新对象的更新频率状态
+    UpdatableObjectRateList _updatableObjectRates;
+    // 上次重新检查时玩家附近被标记的单元格
+    std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP * TOTAL_NUMBER_OF_CELLS_PER_MAP> _playerMarkedCells;
     // 待添加的可更新对象列表
     PendingAddUpdatableObjectList _pendingAddUpdatableObjectList;
     // 可更新对象列表重新检查计时器
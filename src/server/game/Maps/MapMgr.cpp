@@ -59,6 +59,9 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (MapPathfinder::IsEnabled())
+        MapPathfinder::ActivateWorkers(sWorld->getIntConfig(CONFIG_ASYNC_PATHFINDING_THREADS));
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -335,6 +338,8 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    MapPathfinder::DeactivateWorkers();
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
@@ -0,0 +1,243 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapPathfinder.h"
+#include "Metric.h"
+#include "Object.h"
+#include "PCQueue.h"
+#include "PathGenerator.h"
+#include "World.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // requests of one map update, the map thread waits until all of them are calculated
+    struct PathBatch
+    {
+        std::mutex lock;
+        std::condition_variable condition;
+        std::size_t remaining{0};
+    };
+
+    struct PathTask
+    {
+        PathRequest* request;
+        PathBatch* batch;
+    };
+
+    class PathfindingWorkerPool
+    {
+    public:
+        void Activate(std::size_t numThreads)
+        {
+            _cancelationToken = false;
+            _workerThreads.reserve(numThreads);
+            for (std::size_t i = 0; i < numThreads; ++i)
+                _workerThreads.push_back(std::thread(&PathfindingWorkerPool::WorkerThread, this));
+        }
+
+        void Deactivate()
+        {
+            _cancelationToken = true;
+            _queue.Cancel();
+
+            for (std::thread& thread : _workerThreads)
+                if (thread.joinable())
+                    thread.join();
+
+            _workerThreads.clear();
+        }
+
+        void Process(std::vector<PathRequestPtr> const& requests)
+        {
+            PathBatch batch;
+            batch.remaining = requests.size();
+
+            for (PathRequestPtr const& request : requests)
+                _queue.Push(new PathTask{ request.get(), &batch });
+
+            // help out instead of sleeping. every queued task belongs to a map
+            // whose update thread is waiting in here as well, so any of them is safe to run
+            PathTask* task = nullptr;
+            while (_queue.Pop(task))
+            {
+                Run(task);
+                task = nullptr;
+            }
+
+            std::unique_lock<std::mutex> guard(batch.lock);
+            batch.condition.wait(guard, [&batch] { return batch.remaining == 0; });
+        }
+
+    private:
+        void WorkerThread()
+        {
+            while (!_cancelationToken)
+            {
+                PathTask* task = nullptr;
+                _queue.WaitAndPop(task);
+
+                if (!_cancelationToken && task)
+                    Run(task);
+            }
+        }
+
+        static void Run(PathTask* task)
+        {
+            task->request->Calculate();
+
+            PathBatch* batch = task->batch;
+            delete task;
+
+            std::lock_guard<std::mutex> guard(batch->lock);
+            if (--batch->remaining == 0)
+                batch->condition.notify_all();
+        }
+
+        ProducerConsumerQueue<PathTask*> _queue;
+        std::vector<std::thread> _workerThreads;
+        std::atomic<bool> _cancelationToken{false};
+    };
+
+    PathfindingWorkerPool WorkerPool;
+}
+
+PathRequest::PathRequest(std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest, uint32 cost, Callback&& callback) :
+    _path(std::move(path)), _dest(dest), _forceDest(forceDest), _cost(cost), _callback(std::move(callback)), _cancelled(false), _success(false), _deferred(false)
+{
+}
+
+PathRequest::~PathRequest() = default;
+
+void PathRequest::Defer()
+{
+    _path->PrepareDeferredCalculation();
+    _deferred = true;
+}
+
+void PathRequest::Calculate()
+{
+    _success = _path->CalculatePath(_dest.x, _dest.y, _dest.z, _forceDest);
+}
+
+void PathRequest::Complete()
+{
+    if (_cancelled)
+        return;
+
+    // the heights and liquids the workers skipped, grids are only created on the map thread
+    if (_deferred)
+    {
+        _success = _path->FinishDeferredCalculation(_success);
+        _deferred = false;
+    }
+
+    // the callback usually drops the owner's reference to this request
+    Callback callback = std::move(_callback);
+    _cancelled = true;
+    callback(std::move(_path), _success);
+}
+
+MapPathfinder::~MapPathfinder()
+{
+    // owners of the queued requests are gone by now, never calculate them
+    for (PathRequestPtr const& request : _queue)
+        request->Cancel();
+}
+
+PathRequestPtr MapPathfinder::RequestPath(WorldObject const* owner, G3D::Vector3 const& dest, bool forceDest, PathRequest::Callback&& callback,
+    std::unique_ptr<PathGenerator> path /*= nullptr*/, uint32 cost /*= 0*/)
+{
+    if (!path)
+        path = std::make_unique<PathGenerator>(owner);
+
+    // estimate by the number of points of a smooth path to the destination
+    if (!cost)
+        cost = std::min<uint32>(uint32(owner->GetExactDist(dest.x, dest.y, dest.z) / SMOOTH_PATH_STEP_SIZE) + 1, MAX_POINT_PATH_LENGTH);
+
+    PathRequestPtr request = std::make_shared<PathRequest>(std::move(path), dest, forceDest, cost, std::move(callback));
+    _queue.push_back(request);
+    return request;
+}
+
+void MapPathfinder::Update()
+{
+    if (_queue.empty())
+        return;
+
+    uint32 const budget = sWorld->getIntConfig(CONFIG_ASYNC_PATHFINDING_TICK_BUDGET);
+    uint32 spent = 0;
+
+    std::vector<PathRequestPtr> batch;
+    while (!_queue.empty())
+    {
+        PathRequestPtr& request = _queue.front();
+        if (request->IsCancelled())
+        {
+            _queue.pop_front();
+            continue;
+        }
+
+        // always take at least one request, expensive paths must not starve
+        if (budget && !batch.empty() && spent + request->GetCost() > budget)
+            break;
+
+        spent += request->GetCost();
+        batch.push_back(std::move(request));
+        _queue.pop_front();
+    }
+
+    METRIC_VALUE("map_pathfinding_requests", uint64(batch.size()));
+    METRIC_VALUE("map_pathfinding_deferred", uint64(_queue.size()));
+
+    if (batch.empty())
+        return;
+
+    if (batch.size() == 1)
+        batch.front()->Calculate();
+    else
+    {
+        for (PathRequestPtr const& request : batch)
+            request->Defer();
+
+        WorkerPool.Process(batch);
+    }
+
+    // callbacks may queue new requests, those are handled on the next update
+    for (PathRequestPtr const& request : batch)
+        request->Complete();
+}
+
+bool MapPathfinder::IsEnabled()
+{
+    return sWorld->getBoolConfig(CONFIG_ASYNC_PATHFINDING);
+}
+
+void MapPathfinder::ActivateWorkers(std::size_t numThreads)
+{
+    WorkerPool.Activate(numThreads);
+}
+
+void MapPathfinder::DeactivateWorkers()
+{
+    WorkerPool.Deactivate();
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_MAP_PATHFINDER_H
+#define ACORE_MAP_PATHFINDER_H
+
+#include "Define.h"
+#include <G3D/Vector3.h>
+#include <deque>
+#include <functional>
+#include <memory>
+
+class PathGenerator;
+class WorldObject;
+
+// 异步寻路请求
+// 请求在下一次地图更新开始时计算，计算完成后在地图线程上调用回调
+class PathRequest
+{
+public:
+    // 回调参数：计算完成的路径生成器，以及 CalculatePath 的返回值
+    typedef std::function<void(std::unique_ptr<PathGenerator> path, bool success)> Callback;
+
+    PathRequest(std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest, uint32 cost, Callback&& callback);
+    ~PathRequest();
+
+    // 取消请求，回调不会再被调用
+    void Cancel() { _cancelled = true; }
+    // 请求是否已被取消
+    [[nodiscard]] bool IsCancelled() const { return _cancelled; }
+    // 请求的预估开销（路径点数量）
+    [[nodiscard]] uint32 GetCost() const { return _cost; }
+
+    // 在地图线程上调用：之后的计算不访问地图（高度、液体），可以交给寻路工作线程
+    void Defer();
+    // 计算路径，调用期间地图线程必须处于等待状态；除非先调用了 Defer，只能在地图线程上调用
+    void Calculate();
+    // 在地图线程上完成推迟的地图查询并调用回调
+    void Complete();
+
+private:
+    std::unique_ptr<PathGenerator> _path;   // 用于计算的路径生成器
+    G3D::Vector3 _dest;                     // 目标位置
+    bool _forceDest;                        // 是否强制到达目标点
+    uint32 _cost;                           // 预估开销
+    Callback _callback;                     // 完成回调
+    bool _cancelled;                        // 是否已取消
+    bool _success;                          // CalculatePath 的返回值
+    bool _deferred;                         // 地图查询是否推迟到 Complete
+};
+
+typedef std::shared_ptr<PathRequest> PathRequestPtr;
+
+// 每个地图一个的异步寻路队列
+// 移动生成器提交请求后继续当前的移动，请求在下一次地图更新开始时按预算分批计算，
+// 同一批的请求分发到寻路工作线程并行计算。计算期间地图线程处于等待状态，
+// 因此路径生成器可以读取单位的数据；地图的查询（高度、液体）可能创建网格，
+// 工作线程不做这些查询，由地图线程在完成请求时进行
+class MapPathfinder
+{
+public:
+    MapPathfinder() = default;
+    ~MapPathfinder();
+
+    MapPathfinder(MapPathfinder const&) = delete;
+    MapPathfinder& operator=(MapPathfinder const&) = delete;
+
+    // 提交寻路请求，path 为空时为 owner 创建新的路径生成器
+    // cost 为 0 时按起点到终点的距离估算开销
+    // 返回的请求在完成前可以被取消
+    PathRequestPtr RequestPath(WorldObject const* owner, G3D::Vector3 const& dest, bool forceDest, PathRequest::Callback&& callback,
+        std::unique_ptr<PathGenerator> path = nullptr, uint32 cost = 0);
+
+    // 在地图更新开始时调用：在本次更新的预算内计算排队的请求并调用回调
+    void Update();
+
+    // 排队中的请求数量
+    [[nodiscard]] std::size_t GetQueueSize() const { return _queue.size(); }
+
+    // 是否启用了异步寻路
+    static bool IsEnabled();
+    // 启动寻路工作线程
+    static void ActivateWorkers(std::size_t numThreads);
+    // 停止寻路工作线程
+    static void DeactivateWorkers();
+
+private:
+    std::deque<PathRequestPtr> _queue;
+};
+
+#endif
@@ -29,6 +29,7 @@ void HomeMovementGenerator<Creature>::DoInitialize(Creature* owner)
 void HomeMovementGenerator<Creature>::DoFinalize(Creature* owner)
 {
     owner->ClearUnitState(UNIT_STATE_EVADE);
+    owner->InvalidateSightReactionRange();
     if (arrived)
     {
         // Xinef: npc run by default
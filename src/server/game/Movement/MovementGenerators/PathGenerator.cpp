@@ -18,6 +18,7 @@
 #include "PathGenerator.h"
 #include "Creature.h"
 #include "DetourCommon.h"
+#include "Duration.h"
 #include "Geometry.h"
 #include "Log.h"
 #include "MMapFactory.h"
@@ -30,18 +31,10 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _pathCache(nullptr), _deferMapQueries(false), _deferredWork(DEFERRED_NONE)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    uint32 mapId = _source->GetMapId();
-    //if (sDisableMgr->IsPathfindingEnabled(_sourceUnit->FindMap()))
-    {
-        MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
-    }
-
     CreateFilter();
 }
 
@@ -71,22 +64,87 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
     SetStartPosition(start);
 
     _forceDestination = forceDest;
+    _deferredWork = DEFERRED_NONE;
+
+    // the filter looks up the liquid at the source, map lookups are done without the navmesh query held.
+    // deferred calculations had it updated on the map thread
+    if (!_deferMapQueries)
+        UpdateFilter();
 
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
-    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
+    if ((_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) || !AcquireNavMesh() ||
         !HaveTile(start) || !HaveTile(dest))
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
     }
+    else
+        BuildPolyPath(start, dest);
 
+    ReleaseNavMesh();
+    _deferMapQueries = false;
+    return true;
+}
+
+void PathGenerator::PrepareDeferredCalculation()
+{
     UpdateFilter();
+    _deferMapQueries = true;
+}
 
-    BuildPolyPath(start, dest);
-    return true;
+bool PathGenerator::FinishDeferredCalculation(bool success)
+{
+    DeferredMapWork const work = _deferredWork;
+    _deferredWork = DEFERRED_NONE;
+
+    switch (work)
+    {
+        case DEFERRED_NORMALIZE:
+            NormalizePath();
+            break;
+        case DEFERRED_POINT_PATH:
+            FinishPointPath(false);
+            break;
+        case DEFERRED_POINT_PATH_FORCE_DEST:
+            FinishPointPath(true);
+            break;
+        case DEFERRED_RECALCULATE:
+        {
+            G3D::Vector3 const start = GetStartPosition();
+            G3D::Vector3 const dest = GetEndPosition();
+            return CalculatePath(start.x, start.y, start.z, dest.x, dest.y, dest.z, _forceDestination);
+        }
+        default:
+            break;
+    }
+
+    return success;
+}
+
+bool PathGenerator::AcquireNavMesh()
+{
+    // borrow a query from the navmesh pool for the detour calls only,
+    // tiles of the navmesh are not (un)loaded while the handle is held
+    if (!_navMeshQuery)
+    {
+        _query = MMAP::MMapFactory::createOrGetMMapMgr()->AcquireNavMeshQuery(_source->GetMapId());
+        _navMesh = _query.GetNavMesh();
+        _navMeshQuery = _query.get();
+        _pathCache = _query.GetPathCache();
+    }
+
+    return _navMesh && _navMeshQuery;
+}
+
+void PathGenerator::ReleaseNavMesh()
+{
+    // loading a grid loads its navmesh tiles, which waits for every borrowed query of the map
+    _query.Release();
+    _navMesh = nullptr;
+    _navMeshQuery = nullptr;
+    _pathCache = nullptr;
 }
 
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
@@ -179,12 +237,20 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     // its up to caller how he will use this info
     if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF)
     {
-        BuildShortcut();
-
         bool canSwim = creature ? creature->CanSwim() : true;
         bool path = creature ? creature->CanFly() : true;
-        bool waterPath = IsWaterPath(_pathPoints);
-        if (path || (waterPath && canSwim))
+
+        // whether the shortcut is a water path depends on the liquid at its normalized points
+        if (!path && canSwim && _deferMapQueries)
+        {
+            _deferredWork = DEFERRED_RECALCULATE;
+            return;
+        }
+
+        BuildShortcut();
+
+        bool waterPath = !path && canSwim && IsWaterPath(_pathPoints);
+        if (path || waterPath)
         {
             _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
             return;
@@ -210,24 +276,31 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     if (startFarFromPoly || endFarFromPoly)
     {
         bool buildShortcut = false;
-
-        auto liquidDataStart = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), startPos.x, startPos.y, startPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
-        auto liquidDataEnd = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), endPos.x, endPos.y, endPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
-
-        bool startUnderWaterEndInWater = liquidDataStart.Status == LIQUID_MAP_UNDER_WATER &&
-                                         (liquidDataEnd.Status & MAP_LIQUID_STATUS_IN_CONTACT) != 0;
-        bool startInWaterEndUnderWater = (liquidDataStart.Status & MAP_LIQUID_STATUS_IN_CONTACT) != 0 &&
-                                         liquidDataEnd.Status == LIQUID_MAP_UNDER_WATER;
-        bool waterPath = startUnderWaterEndInWater || startInWaterEndUnderWater;
         Unit const* _sourceUnit = _source->ToUnit();
 
         if (_sourceUnit)
         {
-            bool isWater = (_sourceUnit->CanSwim() && waterPath);
-
-            if (isWater || _sourceUnit->CanFly() || (_sourceUnit->IsFalling() && endPos.z < startPos.z))
-            {
+            if (_sourceUnit->CanFly() || (_sourceUnit->IsFalling() && endPos.z < startPos.z))
                 buildShortcut = true;
+            else if (_sourceUnit->CanSwim())
+            {
+                // swimming units take the shortcut between water and underwater, that needs the liquid data of the map
+                if (_deferMapQueries)
+                {
+                    _deferredWork = DEFERRED_RECALCULATE;
+                    return;
+                }
+
+                ReleaseNavMesh();
+
+                auto liquidDataStart = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), startPos.x, startPos.y, startPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
+                auto liquidDataEnd = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), endPos.x, endPos.y, endPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
+
+                bool startUnderWaterEndInWater = liquidDataStart.Status == LIQUID_MAP_UNDER_WATER &&
+                                                 (liquidDataEnd.Status & MAP_LIQUID_STATUS_IN_CONTACT) != 0;
+                bool startInWaterEndUnderWater = (liquidDataStart.Status & MAP_LIQUID_STATUS_IN_CONTACT) != 0 &&
+                                                 liquidDataEnd.Status == LIQUID_MAP_UNDER_WATER;
+                buildShortcut = startUnderWaterEndInWater || startInWaterEndUnderWater;
             }
         }
 
@@ -242,6 +315,14 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
+            // the polygons of a tile unloaded meanwhile are rejected by detour, as those of an old path are
+            if (!AcquireNavMesh())
+            {
+                BuildShortcut();
+                _type = PATHFIND_NOPATH;
+                return;
+            }
+
             float closestPoint[VERTEX_SIZE];
             // we may want to use closestPointOnPolyBoundary instead
             if (dtStatusSucceed(_navMeshQuery->closestPointOnPoly(endPoly, endPoint, closestPoint, nullptr)))
@@ -256,6 +337,14 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
     }
 
+    // a shortcut built for a raycast above gave the query back to the pool
+    if (!AcquireNavMesh())
+    {
+        BuildShortcut();
+        _type = PATHFIND_NOPATH;
+        return;
+    }
+
     // *** poly path generating logic ***
 
     // start and end are on same polygon
@@ -369,14 +458,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                 suffixStartPoly,    // start polygon
                 endPoly,            // end polygon
                 suffixEndPoint,     // start position
                 endPoint,           // end position
-                &_filter,            // polygon search filter
                 _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                (int*)&suffixPolyLength,
+                suffixPolyLength,
                 MAX_PATH_LENGTH - prefixPolyLength); // max number of polygons in output path
         }
 
@@ -472,14 +560,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
+            dtResult = FindPolyPath(
                 startPoly,          // start polygon
                 endPoly,            // end polygon
                 startPoint,         // start position
                 endPoint,           // end position
-                &_filter,           // polygon search filter
                 _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
+                _polyLength,
                 MAX_PATH_LENGTH);   // max number of polygons in output path
         }
 
@@ -517,6 +604,28 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     BuildPointPath(startPoint, endPoint);
 }
 
+dtStatus PathGenerator::FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint, dtPolyRef* path, uint32& pathLength, uint32 maxPath)
+{
+    if (!_pathCache || !_pathCache->IsEnabled())
+        return _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, (int*)&pathLength, maxPath);
+
+    // polygon corridors do not depend on the exact positions inside the polygons,
+    // creatures moving between the same polygons can share them
+    MMAP::PathCacheKey const key = { startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+    if (_pathCache->Find(key, path, pathLength, maxPath))
+        return DT_SUCCESS;
+
+    auto const start = std::chrono::steady_clock::now();
+    dtStatus result = _navMeshQuery->findPath(startPoly, endPoly, startPoint, endPoint, &_filter, path, (int*)&pathLength, maxPath);
+    auto const elapsed = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start);
+
+    // partial paths depend on the search limits, only keep complete ones
+    if (dtStatusSucceed(result) && !dtStatusDetail(result, DT_PARTIAL_RESULT) && pathLength && path[pathLength - 1] == endPoly)
+        _pathCache->Insert(key, path, pathLength, uint64(elapsed.count()));
+
+    return result;
+}
+
 void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoint)
 {
     float pathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
@@ -571,12 +680,8 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
             for (uint32 i = 0; i < pointCount; ++i)
                 _pathPoints[i] = G3D::Vector3(pathPoints[i * VERTEX_SIZE + 2], pathPoints[i * VERTEX_SIZE], pathPoints[i * VERTEX_SIZE + 1]);
 
-            NormalizePath();
-
-            // first point is always our current location - we need the next one
-            SetActualEndPosition(_pathPoints[pointCount - 1]);
-
             _type = PathType(_type | PATHFIND_INCOMPLETE);
+            FinishPointPath(false);
             return;
         }
 
@@ -598,13 +703,25 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
     for (uint32 i = 0; i < pointCount; ++i)
         _pathPoints[i] = G3D::Vector3(pathPoints[i * VERTEX_SIZE + 2], pathPoints[i * VERTEX_SIZE], pathPoints[i * VERTEX_SIZE + 1]);
 
+    FinishPointPath(true);
+}
+
+void PathGenerator::FinishPointPath(bool checkForceDestination)
+{
+    // on a pathfinding worker the map thread finishes the points after the calculation
+    if (_deferMapQueries)
+    {
+        _deferredWork = checkForceDestination ? DEFERRED_POINT_PATH_FORCE_DEST : DEFERRED_POINT_PATH;
+        return;
+    }
+
     NormalizePath();
 
     // first point is always our current location - we need the next one
-    SetActualEndPosition(_pathPoints[pointCount - 1]);
+    SetActualEndPosition(_pathPoints.back());
 
     // force the given destination, if needed
-    if (_forceDestination &&
+    if (checkForceDestination && _forceDestination &&
         (!(_type & PATHFIND_NORMAL) || !InRange(GetEndPosition(), GetActualEndPosition(), 1.0f, 1.0f)))
     {
         // we may want to keep partial subpath
@@ -625,6 +742,16 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
 
 void PathGenerator::NormalizePath()
 {
+    // on a pathfinding worker the map thread normalizes the points after the calculation
+    if (_deferMapQueries)
+    {
+        _deferredWork = DEFERRED_NORMALIZE;
+        return;
+    }
+
+    // the height lookups may create grids and load their navmesh tiles
+    ReleaseNavMesh();
+
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
     {
         _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
@@ -69,6 +69,12 @@
          bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
          // 计算从指定起点到目标点的路径
          bool CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+
+         // 地图线程上调用：更新过滤器，之后的一次 CalculatePath 只做 detour 查询，可以在寻路工作线程上执行
+         void PrepareDeferredCalculation();
+         // 地图线程上调用：完成工作线程留下的地图查询（高度、液体），需要地图数据做决定的路径在这里重新计算
+         // 参数为工作线程上 CalculatePath 的返回值，返回最终的结果
+         bool FinishDeferredCalculation(bool success);
          // 判断目标点的Z坐标是否无效
          [[nodiscard]] bool IsInvalidDestinationZ(Unit const* target) const;
          // 检查两个点之间的路径是否为可行走的攀爬路径（使用float数组）
@@ -168,8 +174,23 @@
          G3D::Vector3 _actualEndPosition;    // 实际可到达的最接近目标的位置
  
          WorldObject const* const _source;       // 正在移动的对象
-         dtNavMesh const* _navMesh;              // 导航网格
-         dtNavMeshQuery const* _navMeshQuery;    // 用于查找路径的查询对象
+         dtNavMesh const* _navMesh;              // 导航网格，仅在 CalculatePath 期间有效
+         dtNavMeshQuery const* _navMeshQuery;    // 从查询池借出的查询对象，仅在 CalculatePath 期间有效
+         MMAP::PathCache* _pathCache;            // 地图的路径缓存，仅在 CalculatePath 期间有效
+         MMAP::NavMeshQueryHandle _query;        // 借出的查询，持有期间导航网格的tile不会被加载或卸载
+
+         // 工作线程上的计算推迟到地图线程完成的地图查询
+         enum DeferredMapWork
+         {
+             DEFERRED_NONE,                  // 没有推迟的查询
+             DEFERRED_NORMALIZE,             // 规范化路径点的高度
+             DEFERRED_POINT_PATH,            // 规范化点路径并设置实际的目标位置
+             DEFERRED_POINT_PATH_FORCE_DEST, // 同上，并处理强制到达目标点
+             DEFERRED_RECALCULATE,           // 路径的选择依赖液体数据，在地图线程上重新计算
+         };
+
+         bool _deferMapQueries;              // 是否推迟地图查询（在工作线程上计算）
+         DeferredMapWork _deferredWork;      // 推迟的地图查询
  
          dtQueryFilterExt _filter;  // 所有移动共用的过滤器，按需更新
  
@@ -179,8 +200,13 @@
          void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
          // 设置实际的目标位置
          void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
-         // 规范化路径
+         // 规范化路径（会访问地图，调用前归还导航网格查询）
          void NormalizePath();
+
+         // 从查询池借出导航网格查询，已持有时直接返回；导航网格不可用时返回false
+         bool AcquireNavMesh();
+         // 归还导航网格查询；之后的地图或地形调用可能创建网格并加载tile，不能持有它
+         void ReleaseNavMesh();
  
          // 检查两点是否在指定范围内
          [[nodiscard]] bool InRange(G3D::Vector3 const& p1, G3D::Vector3 const& p2, float r, float h) const;
@@ -198,8 +224,12 @@
  
          // 构建多边形路径
          void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+         // 查找两个多边形之间的多边形路径，优先使用地图的路径缓存
+         dtStatus FindPolyPath(dtPolyRef startPoly, dtPolyRef endPoly, float const* startPoint, float const* endPoint, dtPolyRef* path, uint32& pathLength, uint32 maxPath);
          // 构建点路径
          void BuildPointPath(float const* startPoint, float const* endPoint);
+         // 规范化点路径并设置实际的目标位置，可选处理强制到达目标点
+         void FinishPointPath(bool checkForceDestination);
          // 构建快捷路径
          void BuildShortcut();
  
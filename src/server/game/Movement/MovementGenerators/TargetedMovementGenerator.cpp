@@ -18,6 +18,7 @@
  #include "TargetedMovementGenerator.h"
  #include "Creature.h"
  #include "CreatureAI.h"
+ #include "Map.h"
  #include "MoveSplineInit.h"
  #include "Pet.h"
  #include "Player.h"
@@ -80,6 +81,7 @@
      // 如果单位无法移动（被定身或施法），或目标丢失，停止移动
      if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || HasLostTarget(owner) || (cOwner && cOwner->IsMovementPreventedByCasting()))
      {
+         CancelPathRequest();
          owner->StopMoving();
          _lastTargetPosition.reset();
          if (cOwner)
@@ -133,6 +135,7 @@
              if ((owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && !target->isMoving() && !mutualChase) || _range)
              {
                  i_recalculateTravel = false;
+                 CancelPathRequest();
                  i_path = nullptr;
                  if (cOwner)
                      cOwner->SetCannotReachTarget();
@@ -172,8 +175,8 @@
              i_leashExtensionTimer.Reset(cOwner->GetAttackTime(BASE_ATTACK));
      }
  
-     // 如果目标位置变化，重新计算路径
-     if (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase || !owner->IsWithinLOSInMap(target))
+     // 如果目标位置变化，重新计算路径（等待异步寻路结果期间继续当前的移动）
+     if (!_pathRequest && (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase || !owner->IsWithinLOSInMap(target)))
      {
          _lastTargetPosition = target->GetPosition();
          _mutualChase = mutualChase;
@@ -237,57 +240,91 @@
              if (owner->IsHovering())
                  owner->UpdateAllowedPositionZ(x, y, z);
  
-             // 计算路径
-             bool success = i_path->CalculatePath(x, y, z, forceDest);
-             if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
+             // 生物的路径交给地图的异步寻路队列计算
+             if (cOwner && MapPathfinder::IsEnabled())
              {
-                 if (cOwner)
-                 {
-                     cOwner->SetCannotReachTarget(target->GetGUID());
-                 }
- 
-                 owner->StopMoving();
+                 Map* map = owner->GetMap();
+                 G3D::Vector3 const dest(x, y, z);
+                 _pathRequest = map->GetPathfinder().RequestPath(owner, dest, forceDest,
+                     [this, owner, map, dest, shortenPath, maxTarget](std::unique_ptr<PathGenerator> path, bool success)
+                     {
+                         _pathRequest = nullptr;
+                         i_path = std::move(path);
+
+                         // 等待期间状态可能已变化，下次更新时重新计算
+                         if (owner->FindMap() != map || !i_target.isValid() || !i_target->IsInWorld() || !owner->IsInMap(i_target.getTarget()) || !owner->IsAlive() ||
+                             owner->GetMotionMaster()->top() != this || owner->HasUnitState(UNIT_STATE_NOT_MOVE) || HasLostTarget(owner))
+                         {
+                             _lastTargetPosition.reset();
+                             return;
+                         }
+
+                         LaunchPath(owner, dest, shortenPath, maxTarget, success);
+                     }, std::move(i_path));
                  return true;
              }
+
+             // 计算路径
+             bool success = i_path->CalculatePath(x, y, z, forceDest);
+             LaunchPath(owner, G3D::Vector3(x, y, z), shortenPath, maxTarget, success);
+         }
+     }
  
-             if (shortenPath)
-                 i_path->ShortenPathUntilDist(G3D::Vector3(x, y, z), maxTarget);
+     return true;
+ }
  
-             if (cOwner)
-             {
-                 cOwner->SetCannotReachTarget();
-             }
+ // 按计算完成的路径开始追逐
+ template<class T>
+ void ChaseMovementGenerator<T>::LaunchPath(T* owner, G3D::Vector3 const& dest, bool shortenPath, float maxTarget, bool success)
+ {
+     Creature* cOwner = owner->ToCreature();
+     Unit* target = i_target.getTarget();
  
-             // 设置移动状态
-             bool walk = false;
-             if (cOwner && !cOwner->IsPet())
-             {
-                 switch (cOwner->GetMovementTemplate().GetChase())
-                 {
-                 case CreatureChaseMovementType::CanWalk:
-                     walk = owner->IsWalking();
-                     break;
-                 case CreatureChaseMovementType::AlwaysWalk:
-                     walk = true;
-                     break;
-                 default:
-                     break;
-                 }
-             }
+     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
+     {
+         if (cOwner)
+         {
+             cOwner->SetCannotReachTarget(target->GetGUID());
+         }
  
-             owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
-             i_recalculateTravel = true;
+         owner->StopMoving();
+         return;
+     }
  
-             // 初始化移动路径
-             Movement::MoveSplineInit init(owner);
-             init.MovebyPath(i_path->GetPath());
-             init.SetFacing(target);
-             init.SetWalk(walk);
-             init.Launch();
+     if (shortenPath)
+         i_path->ShortenPathUntilDist(dest, maxTarget);
+ 
+     if (cOwner)
+     {
+         cOwner->SetCannotReachTarget();
+     }
+ 
+     // 设置移动状态
+     bool walk = false;
+     if (cOwner && !cOwner->IsPet())
+     {
+         switch (cOwner->GetMovementTemplate().GetChase())
+         {
+         case CreatureChaseMovementType::CanWalk:
+             walk = owner->IsWalking();
+             break;
+         case CreatureChaseMovementType::AlwaysWalk:
+             walk = true;
+             break;
+         default:
+             break;
          }
      }
  
-     return true;
+     owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+     i_recalculateTravel = true;
+ 
+     // 初始化移动路径
+     Movement::MoveSplineInit init(owner);
+     init.MovebyPath(i_path->GetPath());
+     init.SetFacing(target);
+     init.SetWalk(walk);
+     init.Launch();
  }
  
  //-----------------------------------------------//
@@ -295,6 +332,7 @@
  template<>
  void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
  {
+     CancelPathRequest();
      i_path = nullptr;
      _lastTargetPosition.reset();
      owner->StopMoving();
@@ -305,6 +343,7 @@
  template<>
  void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
  {
+     CancelPathRequest();
      i_path = nullptr;
      _lastTargetPosition.reset();
      i_recheckDistance.Reset(0);
@@ -317,6 +356,7 @@
  template<class T>
  void ChaseMovementGenerator<T>::DoFinalize(T* owner)
  {
+     CancelPathRequest();
      owner->ClearUnitState(UNIT_STATE_CHASE | UNIT_STATE_CHASE_MOVE);
      if (Creature* cOwner = owner->ToCreature())
      {
@@ -468,6 +508,7 @@
      // 如果无法移动或施法中，停止跟随
      if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || (cOwner && owner->ToCreature()->IsMovementPreventedByCasting()))
      {
+         CancelPathRequest();
          i_path = nullptr;
          owner->StopMoving();
          _lastTargetPosition.reset();
@@ -505,7 +546,7 @@
              owner->SetFacingTo(target->GetOrientation());
          }
      }
-     else
+     else if (!_pathRequest) // 等待异步寻路结果期间继续当前的移动
      {
          Position targetPosition = target->GetPosition();
          _lastTargetPosition = targetPosition;
@@ -542,37 +583,70 @@
          if (owner->IsHovering())
              owner->UpdateAllowedPositionZ(x, y, z);
  
-         // 计算路径
-         bool success = i_path->CalculatePath(x, y, z, forceDest);
-         if (!success || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+         // 生物的路径交给地图的异步寻路队列计算
+         if (cOwner && MapPathfinder::IsEnabled())
          {
-             if (!owner->IsStopped())
-                 owner->StopMoving();
- 
+             Map* map = owner->GetMap();
+             _pathRequest = map->GetPathfinder().RequestPath(owner, G3D::Vector3(x, y, z), forceDest,
+                 [this, owner, map, followingMaster](std::unique_ptr<PathGenerator> path, bool success)
+                 {
+                     _pathRequest = nullptr;
+                     i_path = std::move(path);
+
+                     // 等待期间状态可能已变化，下次更新时重新计算
+                     if (owner->FindMap() != map || !i_target.isValid() || !i_target->IsInWorld() || !owner->IsInMap(i_target.getTarget()) || !owner->IsAlive() ||
+                         owner->GetMotionMaster()->top() != this || owner->HasUnitState(UNIT_STATE_NOT_MOVE))
+                     {
+                         _lastTargetPosition.reset();
+                         return;
+                     }
+
+                     LaunchPath(owner, followingMaster, success);
+                 }, std::move(i_path));
              return true;
          }
+
+         // 计算路径
+         bool success = i_path->CalculatePath(x, y, z, forceDest);
+         LaunchPath(owner, followingMaster, success);
+     }
+ 
+     return true;
+ }
  
-         owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+ // 按计算完成的路径开始跟随
+ template<class T>
+ void FollowMovementGenerator<T>::LaunchPath(T* owner, bool followingMaster, bool success)
+ {
+     Unit* target = i_target.getTarget();
  
-         // 初始化移动路径
-         Movement::MoveSplineInit init(owner);
-         init.MovebyPath(i_path->GetPath());
-         if (_inheritWalkState)
-             init.SetWalk(target->IsWalking() || target->movespline->isWalking());
+     if (!success || (i_path->GetPathType() & PATHFIND_NOPATH && !followingMaster))
+     {
+         if (!owner->IsStopped())
+             owner->StopMoving();
  
-         if (_inheritSpeed)
-             if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
-                 init.SetVelocity(*velocity);
-         init.Launch();
+         return;
      }
  
-     return true;
+     owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+ 
+     // 初始化移动路径
+     Movement::MoveSplineInit init(owner);
+     init.MovebyPath(i_path->GetPath());
+     if (_inheritWalkState)
+         init.SetWalk(target->IsWalking() || target->movespline->isWalking());
+ 
+     if (_inheritSpeed)
+         if (Optional<float> velocity = GetVelocity(owner, target, i_path->GetActualEndPosition(), owner->IsGuardian()))
+             init.SetVelocity(*velocity);
+     init.Launch();
  }
  
  // 初始化跟随行为
  template<class T>
  void FollowMovementGenerator<T>::DoInitialize(T* owner)
  {
+     CancelPathRequest();
      i_path = nullptr;
      _lastTargetPosition.reset();
      owner->AddUnitState(UNIT_STATE_FOLLOW);
@@ -582,6 +656,7 @@
  template<class T>
  void FollowMovementGenerator<T>::DoFinalize(T* owner)
  {
+     CancelPathRequest();
      owner->ClearUnitState(UNIT_STATE_FOLLOW | UNIT_STATE_FOLLOW_MOVE);
  }
  
@@ -19,6 +19,7 @@
  #define ACORE_TARGETEDMOVEMENTGENERATOR_H
  
  #include "FollowerReference.h"
+ #include "MapPathfinder.h"
  #include "MovementGenerator.h"
  #include "Optional.h"
  #include "PathGenerator.h"
@@ -31,11 +32,25 @@
  public:
      // 构造函数，绑定目标单位
      TargetedMovementGeneratorBase(Unit* target) { i_target.link(target, this); }
+     // 析构时取消未完成的寻路请求
+     ~TargetedMovementGeneratorBase() { CancelPathRequest(); }
      // 停止跟随的方法，目前为空实现
      void stopFollowing() { }
  protected:
+     // 取消未完成的异步寻路请求
+     void CancelPathRequest()
+     {
+         if (_pathRequest)
+         {
+             _pathRequest->Cancel();
+             _pathRequest = nullptr;
+         }
+     }
+
      // 跟随目标的引用
      FollowerReference i_target;
+     // 未完成的异步寻路请求，等待期间继续当前的移动
+     PathRequestPtr _pathRequest;
  };
  
  // ChaseMovementGenerator 是一个模板类，用于生成追逐目标的移动逻辑
@@ -76,6 +91,9 @@
      bool HasLostTarget(Unit* unit) const { return unit->GetVictim() != this->GetTarget(); }
  
  private:
+     // 按计算完成的路径开始追逐
+     void LaunchPath(T* owner, G3D::Vector3 const& dest, bool shortenPath, float maxTarget, bool success);
+
      // 拖曳扩展定时器
      TimeTrackerSmall i_leashExtensionTimer;
      // 路径生成器指针
@@ -139,6 +157,9 @@
      float GetFollowRange() const { return _range; }
  
  private:
+     // 按计算完成的路径开始跟随
+     void LaunchPath(T* owner, bool followingMaster, bool success);
+
      // 路径生成器指针
      std::unique_ptr<PathGenerator> i_path;
      // 重新检查预测距离的定时器
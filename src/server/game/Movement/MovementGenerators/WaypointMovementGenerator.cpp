@@ -41,7 +41,8 @@
      if (!path_id)
          path_id = creature->GetWaypointPath();
  
-     i_path = sWaypointMgr->GetPath(path_id);
+     i_store = sWaypointMgr->GetStore();
+     i_path = i_store->GetPath(path_id);
  
      if (!i_path)
      {
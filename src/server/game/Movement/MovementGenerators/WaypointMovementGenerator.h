@@ -160,6 +160,7 @@
      uint32 path_id;                   // 路径 ID
      bool repeating;                   // 是否重复路径
      bool stalled;                     // 是否停滞
+     WaypointStorePtr i_store;         // i_path 所在的路径存储，重载 waypoint_data 后旧路径仍然有效
  };
  
  /**
@@ -22,21 +22,63 @@
 #include "QueryResult.h"
 #include "Timer.h"
 
-WaypointMgr::WaypointMgr()
+namespace
 {
+    // Collects the nodes path after path, the paths only point into the arena once it is complete
+    class WaypointStoreBuilder
+    {
+    public:
+        void AddPath(uint32 pathId)
+        {
+            _ranges.push_back({ pathId, uint32(_nodes.size()), 0 });
+        }
+
+        // adds a node to the last added path
+        void AddNode(WaypointData const& node)
+        {
+            _nodes.push_back(node);
+            ++_ranges.back().Count;
+        }
+
+        void AddPath(uint32 pathId, WaypointPath const& path)
+        {
+            AddPath(pathId);
+            for (WaypointData const& node : path)
+                AddNode(node);
+        }
+
+        WaypointStorePtr Build()
+        {
+            std::shared_ptr<WaypointStore> store = std::make_shared<WaypointStore>();
+            store->Nodes = std::move(_nodes);
+            store->Nodes.shrink_to_fit();
+
+            store->Paths.reserve(_ranges.size());
+            for (PathRange const& range : _ranges)
+                store->Paths.emplace(range.PathId, WaypointPath(store->Nodes.data() + range.First, range.Count));
+
+            return store;
+        }
+
+    private:
+        struct PathRange
+        {
+            uint32 PathId;
+            uint32 First;
+            uint32 Count;
+        };
+
+        std::vector<WaypointData> _nodes;
+        std::vector<PathRange> _ranges;
+    };
 }
 
-WaypointMgr::~WaypointMgr()
+WaypointMgr::WaypointMgr() : _store(std::make_shared<WaypointStore>())
 {
-    for (WaypointPathContainer::iterator itr = _waypointStore.begin(); itr != _waypointStore.end(); ++itr)
-    {
-        for (WaypointPath::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            delete *it;
-
-        itr->second.clear();
-    }
+}
 
-    _waypointStore.clear();
+WaypointMgr::~WaypointMgr()
+{
 }
 
 WaypointMgr* WaypointMgr::instance()
@@ -54,20 +96,29 @@ void WaypointMgr::Load()
 
     if (!result)
     {
+        _store = std::make_shared<WaypointStore>();
         LOG_WARN("server.loading", ">> Loaded 0 waypoints. DB table `waypoint_data` is empty!");
         LOG_INFO("server.loading", " ");
         return;
     }
 
+    WaypointStoreBuilder builder;
     uint32 count = 0;
+    uint32 lastPathId = 0;
+    bool firstRow = true;
 
     do
     {
         Field* fields = result->Fetch();
-        WaypointData* wp = new WaypointData();
+        WaypointData wp;
 
         uint32 pathId = fields[0].Get<uint32>();
-        WaypointPath& path = _waypointStore[pathId];
+        if (firstRow || pathId != lastPathId)
+        {
+            builder.AddPath(pathId);
+            lastPathId = pathId;
+            firstRow = false;
+        }
 
         float x = fields[2].Get<float>();
         float y = fields[3].Get<float>();
@@ -79,87 +130,86 @@ void WaypointMgr::Load()
         Acore::NormalizeMapCoord(x);
         Acore::NormalizeMapCoord(y);
 
-        wp->id = fields[1].Get<uint32>();
-        wp->x = x;
-        wp->y = y;
-        wp->z = z;
-        wp->orientation = o;
-        wp->move_type = fields[6].Get<uint32>();
+        wp.id = fields[1].Get<uint32>();
+        wp.x = x;
+        wp.y = y;
+        wp.z = z;
+        wp.orientation = o;
+        wp.move_type = fields[6].Get<uint32>();
 
-        if (wp->move_type >= WAYPOINT_MOVE_TYPE_MAX)
+        if (wp.move_type >= WAYPOINT_MOVE_TYPE_MAX)
         {
-            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp->id);
-            delete wp;
+            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp.id);
             continue;
         }
 
-        wp->delay = fields[7].Get<uint32>();
-        wp->event_id = fields[8].Get<uint32>();
-        wp->event_chance = fields[9].Get<int16>();
+        wp.delay = fields[7].Get<uint32>();
+        wp.event_id = fields[8].Get<uint32>();
+        wp.event_chance = fields[9].Get<int16>();
 
-        path.push_back(wp);
+        builder.AddNode(wp);
         ++count;
     } while (result->NextRow());
 
+    _store = builder.Build();
+
     LOG_INFO("server.loading", ">> Loaded {} waypoints in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
 void WaypointMgr::ReloadPath(uint32 id)
 {
-    WaypointPathContainer::iterator itr = _waypointStore.find(id);
-    if (itr != _waypointStore.end())
-    {
-        for (WaypointPath::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            delete *it;
-
-        _waypointStore.erase(itr);
-    }
-
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_WAYPOINT_DATA_BY_ID);
 
     stmt->SetData(0, id);
 
     PreparedQueryResult result = WorldDatabase.Query(stmt);
 
-    if (!result)
-        return;
+    // the other paths are copied into the new store, creatures moving along the old one keep it
+    WaypointStoreBuilder builder;
+    for (auto const& [pathId, path] : _store->Paths)
+        if (pathId != id)
+            builder.AddPath(pathId, path);
 
-    WaypointPath& path = _waypointStore[id];
-
-    do
+    if (result)
     {
-        Field* fields = result->Fetch();
-        WaypointData* wp = new WaypointData();
-
-        float x = fields[1].Get<float>();
-        float y = fields[2].Get<float>();
-        float z = fields[3].Get<float>();
-        std::optional<float> o;
-        if (!fields[4].IsNull())
-            o = fields[4].Get<float>();
-
-        Acore::NormalizeMapCoord(x);
-        Acore::NormalizeMapCoord(y);
-
-        wp->id = fields[0].Get<uint32>();
-        wp->x = x;
-        wp->y = y;
-        wp->z = z;
-        wp->orientation = o;
-        wp->move_type = fields[5].Get<uint32>();
+        builder.AddPath(id);
 
-        if (wp->move_type >= WAYPOINT_MOVE_TYPE_MAX)
+        do
         {
-            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp->id);
-            delete wp;
-            continue;
-        }
-
-        wp->delay = fields[6].Get<uint32>();
-        wp->event_id = fields[7].Get<uint32>();
-        wp->event_chance = fields[8].Get<uint8>();
+            Field* fields = result->Fetch();
+            WaypointData wp;
+
+            float x = fields[1].Get<float>();
+            float y = fields[2].Get<float>();
+            float z = fields[3].Get<float>();
+            std::optional<float> o;
+            if (!fields[4].IsNull())
+                o = fields[4].Get<float>();
+
+            Acore::NormalizeMapCoord(x);
+            Acore::NormalizeMapCoord(y);
+
+            wp.id = fields[0].Get<uint32>();
+            wp.x = x;
+            wp.y = y;
+            wp.z = z;
+            wp.orientation = o;
+            wp.move_type = fields[5].Get<uint32>();
+
+            if (wp.move_type >= WAYPOINT_MOVE_TYPE_MAX)
+            {
+                //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp.id);
+                continue;
+            }
+
+            wp.delay = fields[6].Get<uint32>();
+            wp.event_id = fields[7].Get<uint32>();
+            wp.event_chance = fields[8].Get<uint8>();
+
+            builder.AddNode(wp);
+        } while (result->NextRow());
+    }
 
-        path.push_back(wp);
-    } while (result->NextRow());
+    _store = builder.Build();
 }
@@ -19,6 +19,8 @@
 #define ACORE_WAYPOINTMANAGER_H
 
 #include "Define.h"
+#include "Errors.h"
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -44,8 +46,48 @@ struct WaypointData
     uint8 event_chance;
 };
 
-typedef std::vector<WaypointData*> WaypointPath;
-typedef std::unordered_map<uint32, WaypointPath> WaypointPathContainer;
+// The nodes of one path of waypoint_data in point order, a range of the arena of the WaypointStore holding it
+class WaypointPath
+{
+public:
+    WaypointPath(WaypointData const* nodes, uint32 count) : _nodes(nodes), _count(count) { }
+
+    [[nodiscard]] std::size_t size() const { return _count; }
+    [[nodiscard]] bool empty() const { return !_count; }
+
+    [[nodiscard]] WaypointData const* at(std::size_t index) const
+    {
+        ASSERT(index < _count);
+        return _nodes + index;
+    }
+
+    [[nodiscard]] WaypointData const* begin() const { return _nodes; }
+    [[nodiscard]] WaypointData const* end() const { return _nodes + _count; }
+
+private:
+    WaypointData const* _nodes;
+    uint32 _count;
+};
+
+// Every path of waypoint_data packed into one array. A store is never changed once built, reloads build
+// a new one and swap it in. Whoever still walks a path of the old store keeps it alive until done.
+struct WaypointStore
+{
+    // Returns the path from a given id
+    [[nodiscard]] WaypointPath const* GetPath(uint32 id) const
+    {
+        auto itr = Paths.find(id);
+        if (itr != Paths.end())
+            return &itr->second;
+
+        return nullptr;
+    }
+
+    std::vector<WaypointData> Nodes;                // the nodes of all paths, path after path
+    std::unordered_map<uint32, WaypointPath> Paths; // the ranges of Nodes by path id
+};
+
+typedef std::shared_ptr<WaypointStore const> WaypointStorePtr;
 
 class WaypointMgr
 {
@@ -55,24 +97,20 @@ public:
     // Attempts to reload a single path from database
     void ReloadPath(uint32 id);
 
-    // Loads all paths from database, should only run on startup
+    // Loads all paths from database, replacing the loaded ones
     void Load();
 
-    // Returns the path from a given id
-    WaypointPath const* GetPath(uint32 id) const
-    {
-        WaypointPathContainer::const_iterator itr = _waypointStore.find(id);
-        if (itr != _waypointStore.end())
-            return &itr->second;
+    // Returns the path from a given id, only valid until the next reload; keep GetStore() to hold on to it
+    [[nodiscard]] WaypointPath const* GetPath(uint32 id) const { return _store->GetPath(id); }
 
-        return nullptr;
-    }
+    // The paths loaded at the moment. Reloads swap the store from the world thread while no map is updated.
+    [[nodiscard]] WaypointStorePtr GetStore() const { return _store; }
 
 private:
     WaypointMgr();
     ~WaypointMgr();
 
-    WaypointPathContainer _waypointStore;
+    WaypointStorePtr _store;
 };
 
 #define sWaypointMgr WaypointMgr::instance()
@@ -26,7 +26,7 @@
 namespace
 {
     template<class ScriptName>
-    void ForeachMaps(Map* map, std::function<void(ScriptName*)> const& executeHook)
+    void ForeachMaps(Map* map, char const* hookName, std::function<void(ScriptName*)> const& executeHook)
     {
         auto mapEntry = map->GetEntry();
         if (!mapEntry)
@@ -78,6 +78,7 @@ namespace
                 continue;
             }
 
+            ScriptHookProfileScope profileScope(script, hookName);
             executeHook(script);
             return;
         }
@@ -90,19 +91,19 @@ void ScriptMgr::OnCreateMap(Map* map)
 
     CALL_ENABLED_HOOKS(AllMapScript, ALLMAPHOOK_ON_CREATE_MAP, script->OnCreateMap(map));
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnCreate",
     [&](WorldMapScript* script)
     {
         script->OnCreate(map);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnCreate",
     [&](InstanceMapScript* script)
     {
         script->OnCreate((InstanceMap*)map);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnCreate",
     [&](BattlegroundMapScript* script)
     {
         script->OnCreate((BattlegroundMap*)map);
@@ -115,19 +116,19 @@ void ScriptMgr::OnDestroyMap(Map* map)
 
     CALL_ENABLED_HOOKS(AllMapScript, ALLMAPHOOK_ON_DESTROY_MAP, script->OnDestroyMap(map));
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnDestroy",
     [&](WorldMapScript* script)
     {
         script->OnDestroy(map);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnDestroy",
     [&](InstanceMapScript* script)
     {
         script->OnDestroy((InstanceMap*)map);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnDestroy",
     [&](BattlegroundMapScript* script)
     {
         script->OnDestroy((BattlegroundMap*)map);
@@ -138,19 +139,19 @@ void ScriptMgr::OnLoadGridMap(Map* map, GridTerrainData* gmap, uint32 gx, uint32
 {
     ASSERT(map);
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnLoadGridMap",
     [&](WorldMapScript* script)
     {
         script->OnLoadGridMap(map, gmap, gx, gy);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnLoadGridMap",
     [&](InstanceMapScript* script)
     {
         script->OnLoadGridMap((InstanceMap*)map, gmap, gx, gy);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnLoadGridMap",
     [&](BattlegroundMapScript* script)
     {
         script->OnLoadGridMap((BattlegroundMap*)map, gmap, gx, gy);
@@ -162,19 +163,19 @@ void ScriptMgr::OnUnloadGridMap(Map* map, GridTerrainData* gmap, uint32 gx, uint
     ASSERT(map);
     ASSERT(gmap);
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnUnloadGridMap",
     [&](WorldMapScript* script)
     {
         script->OnUnloadGridMap(map, gmap, gx, gy);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnUnloadGridMap",
     [&](InstanceMapScript* script)
     {
         script->OnUnloadGridMap((InstanceMap*)map, gmap, gx, gy);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnUnloadGridMap",
     [&](BattlegroundMapScript* script)
     {
         script->OnUnloadGridMap((BattlegroundMap*)map, gmap, gx, gy);
@@ -193,19 +194,19 @@ void ScriptMgr::OnPlayerEnterMap(Map* map, Player* player)
         script->OnPlayerMapChanged(player);
     });
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnPlayerEnter",
     [&](WorldMapScript* script)
     {
         script->OnPlayerEnter(map, player);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnPlayerEnter",
     [&](InstanceMapScript* script)
     {
         script->OnPlayerEnter((InstanceMap*)map, player);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnPlayerEnter",
     [&](BattlegroundMapScript* script)
     {
         script->OnPlayerEnter((BattlegroundMap*)map, player);
@@ -219,19 +220,19 @@ void ScriptMgr::OnPlayerLeaveMap(Map* map, Player* player)
 
     CALL_ENABLED_HOOKS(AllMapScript, ALLMAPHOOK_ON_PLAYER_LEAVE_ALL, script->OnPlayerLeaveAll(map, player));
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnPlayerLeave",
     [&](WorldMapScript* script)
     {
         script->OnPlayerLeave(map, player);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnPlayerLeave",
     [&](InstanceMapScript* script)
     {
         script->OnPlayerLeave((InstanceMap*)map, player);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnPlayerLeave",
     [&](BattlegroundMapScript* script)
     {
         script->OnPlayerLeave((BattlegroundMap*)map, player);
@@ -244,19 +245,19 @@ void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
 
     CALL_ENABLED_HOOKS(AllMapScript, ALLMAPHOOK_ON_MAP_UPDATE, script->OnMapUpdate(map, diff));
 
-    ForeachMaps<WorldMapScript>(map,
+    ForeachMaps<WorldMapScript>(map, "OnUpdate",
     [&](WorldMapScript* script)
     {
         script->OnUpdate(map, diff);
     });
 
-    ForeachMaps<InstanceMapScript>(map,
+    ForeachMaps<InstanceMapScript>(map, "OnUpdate",
     [&](InstanceMapScript* script)
     {
         script->OnUpdate((InstanceMap*)map, diff);
     });
 
-    ForeachMaps<BattlegroundMapScript>(map,
+    ForeachMaps<BattlegroundMapScript>(map, "OnUpdate",
     [&](BattlegroundMapScript* script)
     {
         script->OnUpdate((BattlegroundMap*)map, diff);
@@ -16,6 +16,7 @@
  */
 
 #include "DynamicObjectScript.h"
+#include "ScriptHookProfiler.h"
 #include "ScriptMgr.h"
 
 void ScriptMgr::OnDynamicObjectUpdate(DynamicObject* dynobj, uint32 diff)
@@ -24,6 +25,7 @@ void ScriptMgr::OnDynamicObjectUpdate(DynamicObject* dynobj, uint32 diff)
 
     for (auto const& [scriptID, script] : ScriptRegistry<DynamicObjectScript>::ScriptPointerList)
     {
+        ScriptHookProfileScope profileScope(script, "OnUpdate");
         script->OnUpdate(dynobj, diff);
     }
 }
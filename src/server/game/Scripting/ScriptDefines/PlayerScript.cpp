@@ -571,11 +571,12 @@ bool ScriptMgr::OnPlayerCanRepopAtGraveyard(Player* player)
 
 Optional<bool> ScriptMgr::OnPlayerIsClass(Player const* player, Classes unitClass, ClassContext context)
 {
-    if (ScriptRegistry<PlayerScript>::EnabledHooks[PLAYERHOOK_ON_PLAYER_IS_CLASS].empty())
+    if (!ScriptRegistry<PlayerScript>::HasEnabledHooks(PLAYERHOOK_ON_PLAYER_IS_CLASS))
         return {};
 
-    for (auto const& script : ScriptRegistry<PlayerScript>::EnabledHooks[PLAYERHOOK_ON_PLAYER_IS_CLASS])
+    for (PlayerScript* script : ScriptRegistry<PlayerScript>::GetEnabledHooks(PLAYERHOOK_ON_PLAYER_IS_CLASS))
     {
+        ScriptHookProfileScope profileScope(script, "PLAYERHOOK_ON_PLAYER_IS_CLASS");
         Optional<bool> scriptResult = script->OnPlayerIsClass(player, unitClass, context);
         if (scriptResult)
             return scriptResult;
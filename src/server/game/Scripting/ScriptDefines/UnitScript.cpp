@@ -51,13 +51,10 @@ void ScriptMgr::ModifyHealReceived(Unit* target, Unit* healer, uint32& heal, Spe
 
 uint32 ScriptMgr::DealDamage(Unit* AttackerUnit, Unit* pVictim, uint32 damage, DamageEffectType damagetype)
 {
-    if (ScriptRegistry<UnitScript>::ScriptPointerList.empty())
-    {
-        return damage;
-    }
-
-    for (auto const& [scriptID, script] : ScriptRegistry<UnitScript>::ScriptPointerList)
+    // no hook type of its own, every unit script is asked on every hit
+    for (UnitScript* script : ScriptRegistry<UnitScript>::Scripts)
     {
+        ScriptHookProfileScope profileScope(script, "DealDamage");
         damage = script->DealDamage(AttackerUnit, pVictim, damage, damagetype);
     }
 
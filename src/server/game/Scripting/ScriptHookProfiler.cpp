@@ -0,0 +1,168 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptHookProfiler.h"
+#include "Metric.h"
+#include "ScriptObject.h"
+#include <algorithm>
+
+std::atomic<bool> ScriptHookProfiler::_enabled{ false };
+
+ScriptHookProfiler* ScriptHookProfiler::instance()
+{
+    static ScriptHookProfiler instance;
+    return &instance;
+}
+
+void ScriptHookProfiler::SetEnabled(bool enabled)
+{
+    _reportTimer.SetInterval(SCRIPT_HOOK_PROFILER_REPORT_INTERVAL);
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void ScriptHookProfiler::Reset()
+{
+    {
+        std::lock_guard<std::mutex> tablesGuard(_tablesLock);
+        for (std::unique_ptr<ThreadTable> const& table : _tables)
+        {
+            std::lock_guard<std::mutex> tableGuard(table->Lock);
+            table->Records.clear();
+        }
+    }
+
+    std::lock_guard<std::mutex> totalsGuard(_totalsLock);
+    _totals.clear();
+}
+
+ScriptHookProfiler::ThreadTable& ScriptHookProfiler::GetThreadTable()
+{
+    thread_local ThreadTable* threadTable = nullptr;
+    if (!threadTable)
+    {
+        // the table outlives its thread, whatever it recorded is still merged
+        std::lock_guard<std::mutex> guard(_tablesLock);
+        _tables.push_back(std::make_unique<ThreadTable>());
+        threadTable = _tables.back().get();
+    }
+
+    return *threadTable;
+}
+
+void ScriptHookProfiler::Record(ScriptObject const* script, char const* hookName, std::chrono::steady_clock::duration time)
+{
+    ThreadTable& table = GetThreadTable();
+
+    std::lock_guard<std::mutex> guard(table.Lock);
+    HookRecord& record = table.Records[{ script, hookName }];
+    ++record.Calls;
+    record.Time += time;
+}
+
+void ScriptHookProfiler::Merge()
+{
+    // takes the records out of every thread table, the scripts are alive until shutdown so their names can be read here
+    {
+        std::lock_guard<std::mutex> tablesGuard(_tablesLock);
+        for (std::unique_ptr<ThreadTable> const& table : _tables)
+        {
+            std::lock_guard<std::mutex> tableGuard(table->Lock);
+            for (auto const& [key, record] : table->Records)
+            {
+                HookRecord& merged = _mergeBuffer[key];
+                merged.Calls += record.Calls;
+                merged.Time += record.Time;
+            }
+
+            table->Records.clear();
+        }
+    }
+
+    for (auto const& [key, record] : _mergeBuffer)
+    {
+        std::string const& scriptName = key.first->GetName();
+        Total& total = _totals[scriptName + ':' + key.second];
+        if (total.Stats.ScriptName.empty())
+        {
+            total.Stats.ScriptName = scriptName;
+            total.Stats.HookName = key.second;
+            total.Stats.Calls = 0;
+            total.Stats.Time = std::chrono::nanoseconds::zero();
+        }
+
+        total.Stats.Calls += record.Calls;
+        total.Stats.Time += std::chrono::duration_cast<std::chrono::nanoseconds>(record.Time);
+    }
+
+    _mergeBuffer.clear();
+}
+
+void ScriptHookProfiler::Update(uint32 diff)
+{
+    if (!IsEnabled())
+        return;
+
+    _reportTimer.Update(diff);
+    if (!_reportTimer.Passed())
+        return;
+
+    _reportTimer.Reset();
+
+    std::lock_guard<std::mutex> guard(_totalsLock);
+    Merge();
+
+    for (auto& [key, total] : _totals)
+    {
+        if (total.Stats.Calls == total.ReportedCalls)
+            continue;
+
+        METRIC_VALUE("script_hook_calls", total.Stats.Calls - total.ReportedCalls,
+            METRIC_TAG("script", total.Stats.ScriptName),
+            METRIC_TAG("hook", total.Stats.HookName));
+
+        METRIC_VALUE("script_hook_time", uint64(std::chrono::duration_cast<std::chrono::microseconds>(total.Stats.Time - total.ReportedTime).count()),
+            METRIC_TAG("script", total.Stats.ScriptName),
+            METRIC_TAG("hook", total.Stats.HookName));
+
+        total.ReportedCalls = total.Stats.Calls;
+        total.ReportedTime = total.Stats.Time;
+    }
+}
+
+std::vector<ScriptHookProfiler::HookStats> ScriptHookProfiler::GetStats(std::size_t count)
+{
+    std::vector<HookStats> stats;
+
+    {
+        std::lock_guard<std::mutex> guard(_totalsLock);
+        Merge();
+
+        stats.reserve(_totals.size());
+        for (auto const& [key, total] : _totals)
+            stats.push_back(total.Stats);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](HookStats const& left, HookStats const& right)
+    {
+        return left.Time > right.Time;
+    });
+
+    if (stats.size() > count)
+        stats.resize(count);
+
+    return stats;
+}
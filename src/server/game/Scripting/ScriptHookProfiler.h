@@ -0,0 +1,143 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SCRIPT_HOOK_PROFILER_H_
+#define _SCRIPT_HOOK_PROFILER_H_
+
+#include "Define.h"
+#include "Timer.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ScriptObject;
+
+#define SCRIPT_HOOK_PROFILER_REPORT_INTERVAL 10 * IN_MILLISECONDS // Time between two reports of the hook times to the metrics
+
+/// Opt-in call counts and time per script and hook of the ScriptMgr hook dispatch.
+/// Every thread records into its own table; the tables are merged into the totals on Update and on request.
+class AC_GAME_API ScriptHookProfiler
+{
+public:
+    struct HookStats
+    {
+        std::string ScriptName;
+        std::string HookName;
+        uint64 Calls;
+        std::chrono::nanoseconds Time;
+    };
+
+    static ScriptHookProfiler* instance();
+
+    [[nodiscard]] static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled);
+
+    /// Drops everything recorded so far
+    void Reset();
+
+    /// Adds one call of the hook of the script, called by the thread that dispatched the hook
+    void Record(ScriptObject const* script, char const* hookName, std::chrono::steady_clock::duration time);
+
+    /// Merges the thread tables every SCRIPT_HOOK_PROFILER_REPORT_INTERVAL and reports the hooks called since the last report to sMetric
+    void Update(uint32 diff);
+
+    /// The totals since the last reset, the most expensive hooks first
+    std::vector<HookStats> GetStats(std::size_t count);
+
+private:
+    ScriptHookProfiler() = default;
+
+    typedef std::pair<ScriptObject const*, char const*> RecordKey;
+
+    struct RecordKeyHash
+    {
+        std::size_t operator()(RecordKey const& key) const
+        {
+            return std::hash<void const*>()(key.first) ^ (std::hash<void const*>()(key.second) << 1);
+        }
+    };
+
+    struct HookRecord
+    {
+        uint64 Calls = 0;
+        std::chrono::steady_clock::duration Time = std::chrono::steady_clock::duration::zero();
+    };
+
+    typedef std::unordered_map<RecordKey, HookRecord, RecordKeyHash> RecordMap;
+
+    // one per thread that dispatched a hook, its owner only contends with the merge
+    struct ThreadTable
+    {
+        std::mutex Lock;
+        RecordMap Records;
+    };
+
+    struct Total
+    {
+        HookStats Stats;
+        uint64 ReportedCalls = 0;
+        std::chrono::nanoseconds ReportedTime = std::chrono::nanoseconds::zero();
+    };
+
+    ThreadTable& GetThreadTable();
+    void Merge();
+
+    static std::atomic<bool> _enabled;
+
+    std::mutex _tablesLock;
+    std::vector<std::unique_ptr<ThreadTable>> _tables;
+
+    std::mutex _totalsLock;
+    std::unordered_map<std::string, Total> _totals;     // by script name and hook name
+    RecordMap _mergeBuffer;
+
+    IntervalTimer _reportTimer;
+};
+
+#define sScriptHookProfiler ScriptHookProfiler::instance()
+
+/// Times one hook call of one script while the profiler is enabled
+class ScriptHookProfileScope
+{
+public:
+    ScriptHookProfileScope(ScriptObject const* script, char const* hookName) : _script(script), _hookName(hookName), _profiled(ScriptHookProfiler::IsEnabled())
+    {
+        if (_profiled)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    ~ScriptHookProfileScope()
+    {
+        if (_profiled)
+            sScriptHookProfiler->Record(_script, _hookName, std::chrono::steady_clock::now() - _start);
+    }
+
+    ScriptHookProfileScope(ScriptHookProfileScope const&) = delete;
+    ScriptHookProfileScope& operator=(ScriptHookProfileScope const&) = delete;
+
+private:
+    ScriptObject const* _script;
+    char const* _hookName;
+    bool _profiled;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#endif
@@ -35,6 +35,11 @@ namespace
         }
 
         ScriptRegistry<T>::ScriptPointerList.clear();
+
+        for (auto& hookScripts : ScriptRegistry<T>::EnabledHooks)
+            hookScripts.clear();
+
+        ScriptRegistry<T>::BuildHookTable();
     }
 }
 
@@ -37,6 +37,7 @@
 #include "Weather.h"
 #include "World.h"
 #include <atomic>
+#include <span>
 
 // Add support old api modules
 #include "AllScriptsObjects.h"
@@ -747,10 +748,50 @@ public:
     // The list of hook types with the list of enabled scripts for this specific hook.
     // With this approach, we wouldn't call all available hooks in case if we override just one hook.
     static EnabledHooksVector EnabledHooks;
+    // EnabledHooks flattened into one array, this is what the hooks are dispatched from.
+    // The scripts of a hook are HookScripts[HookOffsets[hook]] up to HookScripts[HookOffsets[hook + 1]],
+    // so a hook without scripts costs two loads. Rebuilt by BuildHookTable whenever EnabledHooks changes.
+    static std::vector<TScript*> HookScripts;
+    static std::vector<uint32> HookOffsets;
+    // ScriptPointerList in id order, for the hooks called on every script
+    static std::vector<TScript*> Scripts;
 
     static void InitEnabledHooksIfNeeded(uint16 totalAvailableHooks)
     {
         EnabledHooks.resize(totalAvailableHooks);
+        BuildHookTable();
+    }
+
+    static void BuildHookTable()
+    {
+        HookScripts.clear();
+        HookOffsets.assign(EnabledHooks.size() + 1, 0);
+
+        for (std::size_t hook = 0; hook < EnabledHooks.size(); ++hook)
+        {
+            HookOffsets[hook] = uint32(HookScripts.size());
+            HookScripts.insert(HookScripts.end(), EnabledHooks[hook].begin(), EnabledHooks[hook].end());
+        }
+
+        HookOffsets.back() = uint32(HookScripts.size());
+        HookScripts.shrink_to_fit();
+
+        Scripts.clear();
+        Scripts.reserve(ScriptPointerList.size());
+        for (auto const& [scriptID, script] : ScriptPointerList)
+            Scripts.push_back(script);
+
+        _hookTableBuilt = true;
+    }
+
+    [[nodiscard]] static bool HasEnabledHooks(uint16 hook)
+    {
+        return HookOffsets[hook] != HookOffsets[hook + 1];
+    }
+
+    [[nodiscard]] static std::span<TScript* const> GetEnabledHooks(uint16 hook)
+    {
+        return { HookScripts.data() + HookOffsets[hook], HookOffsets[hook + 1] - HookOffsets[hook] };
     }
 
     static void AddScript(TScript* const script, std::vector<uint16> enabledHooks = {})
@@ -761,7 +802,7 @@ public:
             return;
 
         if (EnabledHooks.empty())
-            InitEnabledHooksIfNeeded(script->GetTotalAvailableHooks());
+            EnabledHooks.resize(script->GetTotalAvailableHooks());
 
         if (script->isAfterLoadScript())
         {
@@ -777,6 +818,10 @@ public:
             // We're dealing with a code-only script; just add it.
             ScriptPointerList[_scriptIdCounter++] = script;
             sScriptMgr->IncreaseScriptCount();
+
+            // scripts added before ScriptMgr::Initialize are flattened there, all at once
+            if (_hookTableBuilt)
+                BuildHookTable();
         }
     }
 
@@ -792,7 +837,7 @@ public:
             {
                 if (!_checkMemory(script))
                 {
-                    return;
+                    break;
                 }
 
                 // Get an ID for the script. An ID only exists if it's a script that is assigned in the database
@@ -854,6 +899,8 @@ public:
                 sScriptMgr->IncreaseScriptCount();
             }
         }
+
+        BuildHookTable();
     }
 
     // Gets a script by its ID (assigned by ObjectMgr).
@@ -889,12 +936,18 @@ private:
 
     // Counter used for code-only scripts.
     static uint32 _scriptIdCounter;
+    // Whether ScriptMgr::Initialize flattened the hooks already
+    static bool _hookTableBuilt;
 };
 
 // Instantiate static members of ScriptRegistry.
 template<class TScript> std::map<uint32, TScript*> ScriptRegistry<TScript>::ScriptPointerList;
 template<class TScript> std::vector<std::pair<TScript*,std::vector<uint16>>> ScriptRegistry<TScript>::ALScripts;
 template<class TScript> std::vector<std::vector<TScript*>> ScriptRegistry<TScript>::EnabledHooks;
+template<class TScript> std::vector<TScript*> ScriptRegistry<TScript>::HookScripts;
+template<class TScript> std::vector<uint32> ScriptRegistry<TScript>::HookOffsets;
+template<class TScript> std::vector<TScript*> ScriptRegistry<TScript>::Scripts;
 template<class TScript> uint32 ScriptRegistry<TScript>::_scriptIdCounter = 0;
+template<class TScript> bool ScriptRegistry<TScript>::_hookTableBuilt = false;
 
 #endif
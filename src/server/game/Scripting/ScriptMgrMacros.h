@@ -18,6 +18,7 @@
 #ifndef _SCRIPT_MGR_MACRO_H_
 #define _SCRIPT_MGR_MACRO_H_
 
+#include "ScriptHookProfiler.h"
 #include "ScriptMgr.h"
 
 template<typename ScriptName>
@@ -70,19 +71,19 @@ inline bool ReturnValidBool(Optional<bool> ret, bool need = false)
 }
 
 #define CALL_ENABLED_HOOKS(scriptType, hookType, action) \
-    if (!ScriptRegistry<scriptType>::EnabledHooks[hookType].empty()) \
-        for (auto const& script : ScriptRegistry<scriptType>::EnabledHooks[hookType]) { action; }
+    if (ScriptRegistry<scriptType>::HasEnabledHooks(hookType)) \
+        for (scriptType* script : ScriptRegistry<scriptType>::GetEnabledHooks(hookType)) { ScriptHookProfileScope profileScope(script, #hookType); action; }
 
 #define CALL_ENABLED_BOOLEAN_HOOKS(scriptType, hookType, action) \
-    if (ScriptRegistry<scriptType>::EnabledHooks[hookType].empty()) \
+    if (!ScriptRegistry<scriptType>::HasEnabledHooks(hookType)) \
         return true; \
-    for (auto const& script : ScriptRegistry<scriptType>::EnabledHooks[hookType]) { if (action) return false; } \
+    for (scriptType* script : ScriptRegistry<scriptType>::GetEnabledHooks(hookType)) { ScriptHookProfileScope profileScope(script, #hookType); if (action) return false; } \
     return true;
 
 #define CALL_ENABLED_BOOLEAN_HOOKS_WITH_DEFAULT_FALSE(scriptType, hookType, action) \
-    if (ScriptRegistry<scriptType>::EnabledHooks[hookType].empty()) \
+    if (!ScriptRegistry<scriptType>::HasEnabledHooks(hookType)) \
         return false; \
-    for (auto const& script : ScriptRegistry<scriptType>::EnabledHooks[hookType]) { if (action) return true; } \
+    for (scriptType* script : ScriptRegistry<scriptType>::GetEnabledHooks(hookType)) { ScriptHookProfileScope profileScope(script, #hookType); if (action) return true; } \
     return false;
 
 #endif // _SCRIPT_MGR_MACRO_H_
@@ -0,0 +1,200 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PeriodicAuraLogQueue.h"
+#include "CellImpl.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Log.h"
+#include "Map.h"
+#include "ObjectAccessor.h"
+#include "Pet.h"
+#include "Player.h"
+#include "SpellAuraEffects.h"
+#include "SpellInfo.h"
+#include "World.h"
+#include <algorithm>
+#include <tuple>
+
+PeriodicAuraLogEntry::PeriodicAuraLogEntry(Unit const* target, SpellPeriodicAuraLogInfo const& info)
+{
+    AuraEffect const* aurEff = info.auraEff;
+
+    TargetGUID = target->GetGUID();
+    CasterGUID = aurEff->GetCasterGUID();
+    SpellId = aurEff->GetId();
+    AuraType = aurEff->GetAuraType();
+    MiscValue = aurEff->GetMiscValue();
+    SchoolMask = aurEff->GetSpellInfo()->GetSchoolMask();
+    Damage = info.damage;
+    OverDamage = info.overDamage;
+    Absorb = info.absorb;
+    Resist = info.resist;
+    Multiplier = info.multiplier;
+    Critical = info.critical;
+
+    // IF we are in cheat mode we swap absorb with damage and set damage to 0, this way we can still debug damage but our hp bar will not drop
+    if ((AuraType == SPELL_AURA_PERIODIC_DAMAGE || AuraType == SPELL_AURA_PERIODIC_DAMAGE_PERCENT)
+        && target->IsPlayer() && target->ToPlayer()->GetCommandStatus(CHEAT_GOD))
+    {
+        Absorb = Damage;
+        Damage = 0;
+    }
+}
+
+bool PeriodicAuraLogEntry::Write(WorldPacket& data) const
+{
+    data << uint32(AuraType);                               // auraId
+    switch (AuraType)
+    {
+        case SPELL_AURA_PERIODIC_DAMAGE:
+        case SPELL_AURA_PERIODIC_DAMAGE_PERCENT:
+            data << uint32(Damage);                         // damage
+            data << uint32(OverDamage);                     // overkill?
+            data << uint32(SchoolMask);
+            data << uint32(Absorb);                         // absorb
+            data << uint32(Resist);                         // resist
+            data << uint8(Critical);                        // new 3.1.2 critical tick
+            break;
+        case SPELL_AURA_PERIODIC_HEAL:
+        case SPELL_AURA_OBS_MOD_HEALTH:
+            data << uint32(Damage);                         // damage
+            data << uint32(OverDamage);                     // overheal
+            data << uint32(Absorb);                         // absorb
+            data << uint8(Critical);                        // new 3.1.2 critical tick
+            break;
+        case SPELL_AURA_OBS_MOD_POWER:
+        case SPELL_AURA_PERIODIC_ENERGIZE:
+            data << uint32(MiscValue);                      // power type
+            data << uint32(Damage);                         // damage
+            break;
+        case SPELL_AURA_PERIODIC_MANA_LEECH:
+            data << uint32(MiscValue);                      // power type
+            data << uint32(Damage);                         // amount
+            data << float(Multiplier);                      // gain multiplier
+            break;
+        default:
+            LOG_ERROR("entities.unit", "PeriodicAuraLogEntry::Write: unknown aura {}", AuraType);
+            return false;
+    }
+
+    return true;
+}
+
+void PeriodicAuraLogQueue::Add(Unit const* target, SpellPeriodicAuraLogInfo const& info)
+{
+    _entries.emplace_back(target, info);
+}
+
+void PeriodicAuraLogQueue::Flush(Map* map)
+{
+    if (_entries.empty())
+        return;
+
+    // group the entries by target and then by caster and spell, ticks of one target keep their order
+    std::stable_sort(_entries.begin(), _entries.end(), [](PeriodicAuraLogEntry const& left, PeriodicAuraLogEntry const& right)
+    {
+        return std::tie(left.TargetGUID, left.CasterGUID, left.SpellId) < std::tie(right.TargetGUID, right.CasterGUID, right.SpellId);
+    });
+
+    for (auto targetItr = _entries.begin(); targetItr != _entries.end();)
+    {
+        auto targetEnd = std::find_if(targetItr, _entries.end(), [guid = targetItr->TargetGUID](PeriodicAuraLogEntry const& entry)
+        {
+            return entry.TargetGUID != guid;
+        });
+
+        Unit* target = nullptr;
+        if (targetItr->TargetGUID.IsPlayer())
+            target = ObjectAccessor::GetPlayer(map, targetItr->TargetGUID);
+        else if (targetItr->TargetGUID.IsPet())
+            target = map->GetPet(targetItr->TargetGUID);
+        else
+            target = map->GetCreature(targetItr->TargetGUID);
+
+        // the target left the map during this update, nobody sees it anymore
+        if (!target || !target->IsInWorld())
+        {
+            targetItr = targetEnd;
+            continue;
+        }
+
+        // one SMSG_PERIODICAURALOG per caster and spell, it can carry several aura entries
+        _packets.clear();
+        _packetCasters.clear();
+        for (auto spellItr = targetItr; spellItr != targetEnd;)
+        {
+            auto spellEnd = std::find_if(spellItr, targetEnd, [spellItr](PeriodicAuraLogEntry const& entry)
+            {
+                return entry.CasterGUID != spellItr->CasterGUID || entry.SpellId != spellItr->SpellId;
+            });
+
+            WorldPacket data(SMSG_PERIODICAURALOG, 30 + 25 * std::distance(spellItr, spellEnd));
+            data << target->GetPackGUID();
+            data << spellItr->CasterGUID.WriteAsPacked();
+            data << uint32(spellItr->SpellId);                  // spellId
+            std::size_t countPos = data.wpos();
+            data << uint32(0);                                  // count
+
+            uint32 count = 0;
+            for (auto itr = spellItr; itr != spellEnd; ++itr)
+            {
+                // an unknown aura type leaves a partial entry behind, the packet can not be sent anymore
+                if (!itr->Write(data))
+                {
+                    count = 0;
+                    break;
+                }
+
+                ++count;
+            }
+
+            if (count)
+            {
+                data.put<uint32>(countPos, count);
+                _packets.push_back(std::move(data));
+                _packetCasters.push_back(spellItr->CasterGUID);
+            }
+
+            spellItr = spellEnd;
+        }
+
+        if (!_packets.empty() && sWorld->getBoolConfig(CONFIG_COMBAT_LOG_DISPATCHER))
+        {
+            // observer filtering and bandwidth caps are done by the dispatcher
+            CombatLogDispatcher& dispatcher = map->GetCombatLogDispatcher();
+            for (std::size_t i = 0; i < _packets.size(); ++i)
+                dispatcher.Queue(target, _packetCasters[i], target->GetGUID(), std::move(_packets[i]));
+        }
+        else if (!_packets.empty())
+        {
+            if (Player* player = target->ToPlayer())
+                for (WorldPacket const& packet : _packets)
+                    player->SendDirectMessage(&packet);
+
+            float range = target->GetVisibilityRange();
+            Acore::MessageDistDeliverer notifier(target, _packets, range);
+            Cell::VisitWorldObjects(target, notifier, range);
+        }
+
+        targetItr = targetEnd;
+    }
+
+    _entries.clear();
+    _packets.clear();
+    _packetCasters.clear();
+}
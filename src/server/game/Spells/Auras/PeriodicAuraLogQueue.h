@@ -0,0 +1,71 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_PERIODIC_AURA_LOG_QUEUE_H
+#define ACORE_PERIODIC_AURA_LOG_QUEUE_H
+
+#include "ObjectGuid.h"
+#include "WorldPacket.h"
+#include <vector>
+
+class Map;
+class Unit;
+struct SpellPeriodicAuraLogInfo;
+
+// 周期性光环战斗日志（SMSG_PERIODICAURALOG）中的一条光环记录
+// 入队时复制所需的全部数据，光环效果在日志发送前可能已经被移除
+struct PeriodicAuraLogEntry
+{
+    PeriodicAuraLogEntry(Unit const* target, SpellPeriodicAuraLogInfo const& info);
+
+    // 写入一条光环记录（不含包头），未知的光环类型返回 false
+    bool Write(WorldPacket& data) const;
+
+    ObjectGuid TargetGUID;
+    ObjectGuid CasterGUID;
+    uint32 SpellId;
+    uint32 AuraType;
+    int32 MiscValue;
+    uint32 SchoolMask;
+    uint32 Damage;
+    uint32 OverDamage;
+    uint32 Absorb;
+    uint32 Resist;
+    float Multiplier;
+    bool Critical;
+};
+
+// 地图级的周期性光环日志队列
+// 周期效果的伤害和治疗仍在各自的跳数中立即结算，只有战斗日志推迟到本次地图更新的单位更新结束后发送：
+// 同一目标的日志只遍历一次周围的观察者，同一施法者同一法术的多条记录合并到一个包中
+class PeriodicAuraLogQueue
+{
+public:
+    void Add(Unit const* target, SpellPeriodicAuraLogInfo const& info);
+
+    // 发送所有排队的日志，在地图线程上调用
+    void Flush(Map* map);
+
+    [[nodiscard]] bool IsEmpty() const { return _entries.empty(); }
+
+private:
+    std::vector<PeriodicAuraLogEntry> _entries;
+    std::vector<WorldPacket> _packets;          // 复用的单个目标的包列表
+    std::vector<ObjectGuid> _packetCasters;     // 与 _packets 一一对应的施法者
+};
+
+#endif
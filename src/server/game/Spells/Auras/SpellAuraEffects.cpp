@@ -430,6 +430,27 @@ void AuraEffect::GetApplicationList(std::list<AuraApplication*>& applicationList
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetModifiers();
+}
+
+void AuraEffect::SetEnabled(bool enabled)
+{
+    m_isAuraEnabled = enabled;
+    InvalidateTargetModifiers();
+}
+
+// amount of the effect changed, targets have to recalculate their aura modifiers of this type
+void AuraEffect::InvalidateTargetModifiers()
+{
+    Aura::ApplicationMap const& targetMap = GetBase()->GetApplicationMap();
+    for (Aura::ApplicationMap::const_iterator appIter = targetMap.begin(); appIter != targetMap.end(); ++appIter)
+        appIter->second->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
 uint32 AuraEffect::GetId() const
 {
     return m_spellInfo->Id;
@@ -734,7 +755,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetModifiers();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -6647,7 +6671,8 @@ void AuraEffect::HandlePeriodicDamageAurasTick(Unit* target, Unit* caster) const
     }
 
     // Script Hook For HandlePeriodicDamageAurasTick -- Allow scripts to change the Damage pre class mitigation calculations
-    sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, damage, GetSpellInfo());
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK))
+        sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, damage, GetSpellInfo());
 
     if (target->GetAI())
     {
@@ -6770,7 +6795,8 @@ void AuraEffect::HandlePeriodicHealthLeechAuraTick(Unit* target, Unit* caster) c
     uint32 damage = std::max(GetAmount(), 0);
 
     // Script Hook For HandlePeriodicHealthLeechAurasTick -- Allow scripts to change the Damage pre class mitigation calculations
-    sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, damage, GetSpellInfo());
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK))
+        sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, damage, GetSpellInfo());
 
     if (target->GetAI())
     {
@@ -6985,8 +7011,11 @@ void AuraEffect::HandlePeriodicHealAurasTick(Unit* target, Unit* caster) const
     uint32 heal = uint32(damage);
 
     // Script Hook For HandlePeriodicDamageAurasTick -- Allow scripts to change the Damage pre class mitigation calculations
-    sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, heal, GetSpellInfo());
-    sScriptMgr->ModifyHealReceived(target, caster, heal, GetSpellInfo());
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_PERIODIC_DAMAGE_AURAS_TICK))
+        sScriptMgr->ModifyPeriodicDamageAurasTick(target, caster, heal, GetSpellInfo());
+
+    if (ScriptRegistry<UnitScript>::HasEnabledHooks(UNITHOOK_MODIFY_HEAL_RECEIVED))
+        sScriptMgr->ModifyHealReceived(target, caster, heal, GetSpellInfo());
 
     if (target->GetAI())
     {
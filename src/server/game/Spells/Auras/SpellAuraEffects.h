@@ -63,7 +63,7 @@ public:
     AuraType GetAuraType() const;
     int32 GetAmount() const { return m_isAuraEnabled ? m_amount : 0; }
     int32 GetForcedAmount() const { return m_amount; }
-    void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+    void SetAmount(int32 amount);
 
     int32 GetPeriodicTimer() const { return m_periodicTimer; }
     void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
@@ -116,7 +116,7 @@ public:
     uint32 GetAuraGroup() const { return m_auraGroup; }
     int32 GetOldAmount() const { return m_oldAmount; }
     void SetOldAmount(int32 amount) { m_oldAmount = amount; }
-    void SetEnabled(bool enabled) { m_isAuraEnabled = enabled; }
+    void SetEnabled(bool enabled);
 
 private:
     Aura* const m_base;
@@ -149,6 +149,7 @@ private:
     bool m_isPeriodic;
 private:
     float CalcPeriodicCritChance(Unit const* caster, Unit const* target) const;
+    void InvalidateTargetModifiers();
 
 public:
     // aura effect apply/remove handlers
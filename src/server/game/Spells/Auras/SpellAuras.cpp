@@ -2630,6 +2630,15 @@ void Aura::CallScriptEffectSplitHandlers(AuraEffect* aurEff, AuraApplication con
     }
 }
 
+bool Aura::HasCheckProcScripts() const
+{
+    for (AuraScript* script : m_loadedScripts)
+        if (script->DoCheckProc.size() || script->DoAfterCheckProc.size())
+            return true;
+
+    return false;
+}
+
 bool Aura::CallScriptCheckProcHandlers(AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
     bool result = true;
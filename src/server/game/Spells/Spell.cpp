@@ -515,6 +515,23 @@ void SpellCastTargets::Update(Unit* caster)
     }
 }
 
+// Target search buffer borrowed from the caster's map for one target selection
+class SpellTargetSearchBuffer
+{
+public:
+    explicit SpellTargetSearchBuffer(Map* map) : _map(map), _targets(map->AcquireTargetSearchBuffer()) { }
+    ~SpellTargetSearchBuffer() { _map->ReleaseTargetSearchBuffer(std::move(_targets)); }
+
+    SpellTargetSearchBuffer(SpellTargetSearchBuffer const&) = delete;
+    SpellTargetSearchBuffer& operator=(SpellTargetSearchBuffer const&) = delete;
+
+    std::vector<WorldObject*>& Get() { return _targets; }
+
+private:
+    Map* _map;
+    std::vector<WorldObject*> _targets;
+};
+
 class SpellEvent : public BasicEvent
 {
     public:
@@ -1218,7 +1235,8 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
         ASSERT(false && "Spell::SelectImplicitConeTargets: received not implemented target reference type");
         return;
     }
-    std::list<WorldObject*> targets;
+    SpellTargetSearchBuffer searchBuffer(m_caster->GetMap());
+    std::vector<WorldObject*>& targets = searchBuffer.Get();
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
     ConditionList* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
@@ -1246,13 +1264,13 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
                 Acore::Containers::RandomResize(targets, maxTargets);
             }
 
-            for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+            for (WorldObject* target : targets)
             {
-                if (Unit* unit = (*itr)->ToUnit())
+                if (Unit* unit = target->ToUnit())
                 {
                     AddUnitTarget(unit, effMask, false);
                 }
-                else if (GameObject* gObjTarget = (*itr)->ToGameObject())
+                else if (GameObject* gObjTarget = target->ToGameObject())
                 {
                     AddGOTarget(gObjTarget, effMask);
                 }
@@ -1314,7 +1332,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
     }
 
     // Xinef: the distance should be increased by caster size, it is neglected in latter calculations
-    std::list<WorldObject*> targets;
+    SpellTargetSearchBuffer searchBuffer(m_caster->GetMap());
+    std::vector<WorldObject*>& targets = searchBuffer.Get();
     float radius = m_spellInfo->Effects[effIndex].CalcRadius(m_caster) * m_spellValue->RadiusMod;
     SearchAreaTargets(targets, radius, center, referer, targetType.GetObjectType(), targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
 
@@ -1333,11 +1352,11 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Acore::Containers::RandomResize(targets, maxTargets);
         }
 
-        for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        for (WorldObject* target : targets)
         {
-            if (Unit* unitTarget = (*itr)->ToUnit())
+            if (Unit* unitTarget = target->ToUnit())
                 AddUnitTarget(unitTarget, effMask, false);
-            else if (GameObject* gObjTarget = (*itr)->ToGameObject())
+            else if (GameObject* gObjTarget = target->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
     }
@@ -1457,13 +1476,24 @@ void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplici
                     const uint8 numChecks = std::ceil(std::fabs(distance / step));
                     const float DELTA_X = (destx - pos.GetPositionX()) / numChecks;
                     const float DELTA_Y = (desty - pos.GetPositionY()) / numChecks;
+
+                    // every step samples the terrain at the same point up to four times, fetch the grid heights once
+                    std::vector<float> stepX(numChecks), stepY(numChecks), stepGridZ(numChecks);
+                    for (uint8 i = 0; i < numChecks; ++i)
+                    {
+                        stepX[i] = pos.GetPositionX() + (float(i + 1) * DELTA_X);
+                        stepY[i] = pos.GetPositionY() + (float(i + 1) * DELTA_Y);
+                    }
+                    map->GetGridHeights(stepX.data(), stepY.data(), stepGridZ.data(), numChecks);
+
                     int j = 1;
                     for (; j < (numChecks + 1); j++)
                     {
                         prevX = pos.GetPositionX() + (float(j - 1) * DELTA_X);
                         prevY = pos.GetPositionY() + (float(j - 1) * DELTA_Y);
-                        tstX = pos.GetPositionX() + (float(j) * DELTA_X);
-                        tstY = pos.GetPositionY() + (float(j) * DELTA_Y);
+                        tstX = stepX[j - 1];
+                        tstY = stepY[j - 1];
+                        float const tstGridZ = stepGridZ[j - 1];
 
                         if (j < 2)
                         {
@@ -1474,7 +1504,7 @@ void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplici
                             prevZ = tstZ;
                         }
 
-                        tstZ = map->GetHeight(phasemask, tstX, tstY, prevZ + maxtravelDistZ, true);
+                        tstZ = map->GetHeightWithGridHeight(phasemask, tstGridZ, tstX, tstY, prevZ + maxtravelDistZ, true, DEFAULT_HEIGHT_SEARCH);
                         ground = tstZ;
 
                         if (!isCasterInWater)
@@ -1516,11 +1546,11 @@ void Spell::SelectImplicitCasterDestTargets(SpellEffIndex effIndex, SpellImplici
                                 inwater = false;
 
                             // highest available point
-                            tstZ1 = map->GetHeight(phasemask, tstX, tstY, prevZ + maxtravelDistZ, true, 25.0f);
+                            tstZ1 = map->GetHeightWithGridHeight(phasemask, tstGridZ, tstX, tstY, prevZ + maxtravelDistZ, true, 25.0f);
                             // upper or floor
-                            tstZ2 = map->GetHeight(phasemask, tstX, tstY, prevZ, true, 25.0f);
+                            tstZ2 = map->GetHeightWithGridHeight(phasemask, tstGridZ, tstX, tstY, prevZ, true, 25.0f);
                             //lower than floor
-                            tstZ3 = map->GetHeight(phasemask, tstX, tstY, prevZ - maxtravelDistZ / 2, true, 25.0f);
+                            tstZ3 = map->GetHeightWithGridHeight(phasemask, tstGridZ, tstX, tstY, prevZ - maxtravelDistZ / 2, true, 25.0f);
 
                             //distance of rays, will select the shortest in 3D
                             srange1 = sqrt((tstY - prevY) * (tstY - prevY) + (tstX - prevX) * (tstX - prevX) + (tstZ1 - prevZ) * (tstZ1 - prevZ));
@@ -2193,7 +2223,7 @@ WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objec
     return target;
 }
 
-void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, Unit* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList)
+void Spell::SearchAreaTargets(std::vector<WorldObject*>& targets, float range, Position const* position, Unit* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList)
 {
     uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList);
     if (!containerTypeMask)
@@ -2238,62 +2268,84 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
     if (isBouncingFar)
         searchRadius *= chainTargets;
 
-    std::list<WorldObject*> tempTargets;
+    SpellTargetSearchBuffer searchBuffer(m_caster->GetMap());
+    std::vector<WorldObject*>& tempTargets = searchBuffer.Get();
     SearchAreaTargets(tempTargets, searchRadius, target, m_caster, objectType, selectType, condList);
-    tempTargets.remove(target);
+    tempTargets.erase(std::remove(tempTargets.begin(), tempTargets.end(), target), tempTargets.end());
 
     // remove targets which are always invalid for chain spells
     // for some spells allow only chain targets in front of caster (swipe for example)
     if (!isBouncingFar)
     {
-        for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end();)
+        tempTargets.erase(std::remove_if(tempTargets.begin(), tempTargets.end(), [this](WorldObject* object)
         {
-            std::list<WorldObject*>::iterator checkItr = itr++;
-            if (!m_caster->HasInArc(static_cast<float>(M_PI), *checkItr))
-                tempTargets.erase(checkItr);
-        }
+            return !m_caster->HasInArc(static_cast<float>(M_PI), object);
+        }), tempTargets.end());
     }
 
-    while (chainTargets)
+    // candidates of a jump ordered by preference, ties keep the search order
+    // only the best ones are taken from the heap until one passes the distance and los checks
+    // chain heals prefer the highest health deficit, closest object otherwise
+    std::vector<std::pair<int64, std::size_t>> healCandidates;
+    std::vector<std::pair<float, std::size_t>> distanceCandidates;
+    if (isChainHeal)
+        healCandidates.reserve(tempTargets.size());
+    else
+        distanceCandidates.reserve(tempTargets.size());
+
+    auto selectCandidate = [&](auto& candidates) -> std::size_t
+    {
+        using Candidate = typename std::decay_t<decltype(candidates)>::value_type;
+        auto isWorse = [](Candidate const& left, Candidate const& right)
+        {
+            return left.first != right.first ? left.first > right.first : left.second > right.second;
+        };
+
+        std::make_heap(candidates.begin(), candidates.end(), isWorse);
+
+        while (!candidates.empty())
+        {
+            std::pop_heap(candidates.begin(), candidates.end(), isWorse);
+            WorldObject* candidate = tempTargets[candidates.back().second];
+            bool checkDist = isChainHeal || isBouncingFar;
+            if ((!checkDist || target->IsWithinDist(candidate, jumpRadius)) && target->IsWithinLOSInMap(candidate, VMAP::ModelIgnoreFlags::M2))
+                return candidates.back().second;
+
+            candidates.pop_back();
+        }
+
+        return tempTargets.size();
+    };
+
+    while (chainTargets && !tempTargets.empty())
     {
-        // try to get unit for next chain jump
-        std::list<WorldObject*>::iterator foundItr = tempTargets.end();
+        std::size_t found;
         // get unit with highest hp deficit in dist
         if (isChainHeal)
         {
-            uint32 maxHPDeficit = 0;
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
-            {
-                if (Unit* unit = (*itr)->ToUnit())
-                {
-                    uint32 deficit = unit->GetMaxHealth() - unit->GetHealth();
-                    if (deficit > maxHPDeficit && target->IsWithinDist(unit, jumpRadius) && target->IsWithinLOSInMap(unit, VMAP::ModelIgnoreFlags::M2))
-                    {
-                        foundItr = itr;
-                        maxHPDeficit = deficit;
-                    }
-                }
-            }
+            healCandidates.clear();
+            for (std::size_t i = 0; i < tempTargets.size(); ++i)
+                if (Unit* unit = tempTargets[i]->ToUnit())
+                    if (uint32 deficit = unit->GetMaxHealth() - unit->GetHealth())
+                        healCandidates.emplace_back(-int64(deficit), i);
+
+            found = selectCandidate(healCandidates);
         }
         // get closest object
         else
         {
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
-            {
-                if (foundItr == tempTargets.end())
-                {
-                    if ((!isBouncingFar || target->IsWithinDist(*itr, jumpRadius)) && target->IsWithinLOSInMap(*itr, VMAP::ModelIgnoreFlags::M2))
-                        foundItr = itr;
-                }
-                else if (target->GetDistanceOrder(*itr, *foundItr) && target->IsWithinLOSInMap(*itr, VMAP::ModelIgnoreFlags::M2))
-                    foundItr = itr;
-            }
+            distanceCandidates.clear();
+            for (std::size_t i = 0; i < tempTargets.size(); ++i)
+                distanceCandidates.emplace_back(target->GetExactDistSq(tempTargets[i]), i);
+
+            found = selectCandidate(distanceCandidates);
         }
+
         // not found any valid target - chain ends
-        if (foundItr == tempTargets.end())
+        if (found == tempTargets.size())
             break;
-        target = *foundItr;
-        tempTargets.erase(foundItr);
+        target = tempTargets[found];
+        tempTargets.erase(tempTargets.begin() + found);
         targets.push_back(target);
         --chainTargets;
     }
@@ -8732,6 +8784,27 @@ void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& ta
     }
 }
 
+void Spell::CallScriptObjectAreaTargetSelectHandlers(std::vector<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
+{
+    if (!HasScriptObjectAreaTargetSelectHandlers(effIndex, targetType))
+        return;
+
+    // script hooks work on a list, only build one when a script is going to see it
+    std::list<WorldObject*> scriptTargets(targets.begin(), targets.end());
+    CallScriptObjectAreaTargetSelectHandlers(scriptTargets, effIndex, targetType);
+    targets.assign(scriptTargets.begin(), scriptTargets.end());
+}
+
+bool Spell::HasScriptObjectAreaTargetSelectHandlers(SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
+{
+    for (SpellScript* script : m_loadedScripts)
+        for (SpellScript::ObjectAreaTargetSelectHandler& hook : script->OnObjectAreaTargetSelect)
+            if (hook.IsEffectAffected(m_spellInfo, effIndex) && targetType.GetTarget() == hook.GetTarget())
+                return true;
+
+    return false;
+}
+
 void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
@@ -9094,7 +9167,7 @@ namespace Acore
     {
     }
 
-    bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target)
+    bool WorldObjectSpellAreaTargetCheck::IsInArea(WorldObject* target) const
     {
         if (target->IsGameObject())
         {
@@ -9105,7 +9178,12 @@ namespace Acore
             return false;
         else if (target->IsCreature() && target->ToCreature()->IsAvoidingAOE()) // pussywizard
             return false;
-        return WorldObjectSpellTargetCheck::operator ()(target);
+        return true;
+    }
+
+    bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target)
+    {
+        return IsInArea(target) && WorldObjectSpellTargetCheck::operator ()(target);
     }
 
     WorldObjectSpellConeTargetCheck::WorldObjectSpellConeTargetCheck(float coneAngle, float range, Unit* caster,
@@ -9116,6 +9194,10 @@ namespace Acore
 
     bool WorldObjectSpellConeTargetCheck::operator()(WorldObject* target)
     {
+        // the area check is much cheaper than the angle checks, reject the objects out of range first
+        if (!IsInArea(target))
+            return false;
+
         if (_spellInfo->HasAttribute(SPELL_ATTR0_CU_CONE_BACK))
         {
             if (!_caster->isInBack(target, _coneAngle))
@@ -9131,7 +9213,7 @@ namespace Acore
             if (!_caster->isInFront(target, _coneAngle))
                 return false;
         }
-        return WorldObjectSpellAreaTargetCheck::operator ()(target);
+        return WorldObjectSpellTargetCheck::operator ()(target);
     }
 
     WorldObjectSpellTrajTargetCheck::WorldObjectSpellTrajTargetCheck(float range, Position const* position, Unit* caster,
@@ -9142,10 +9224,13 @@ namespace Acore
 
     bool WorldObjectSpellTrajTargetCheck::operator()(WorldObject* target)
     {
+        if (!IsInArea(target))
+            return false;
+
         // return all targets on missile trajectory (0 - size of a missile)
         if (!_caster->HasInLine(target, target->GetObjectSize()))
             return false;
-        return WorldObjectSpellAreaTargetCheck::operator ()(target);
+        return WorldObjectSpellTargetCheck::operator ()(target);
     }
 
 } //namespace Acore
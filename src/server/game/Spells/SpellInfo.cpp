@@ -861,6 +861,8 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
     _isSpellValid = true;
     _isCritCapable = false;
     _requireCooldownInfo = false;
+
+    _InitializeEffectMasks();
 }
 
 SpellInfo::~SpellInfo()
@@ -875,43 +877,27 @@ uint32 SpellInfo::GetCategory() const
 
 bool SpellInfo::HasEffect(SpellEffects effect) const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsEffect(effect))
-            return true;
-    return false;
+    return effect < TOTAL_SPELL_EFFECTS && _effectMask[effect];
 }
 
 bool SpellInfo::HasEffectMechanic(Mechanics mechanic) const
 {
-    for (auto const& effect : Effects)
-        if (effect.Mechanic == mechanic)
-            return true;
-
-    return false;
+    return mechanic < MAX_MECHANIC && (_effectMechanicMask & (1 << mechanic));
 }
 
 bool SpellInfo::HasAura(AuraType aura) const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsAura(aura))
-            return true;
-    return false;
+    return aura < TOTAL_AURAS && _auraTypeMask[aura];
 }
 
 bool SpellInfo::HasAnyAura() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsAura())
-            return true;
-    return false;
+    return _hasAnyAura;
 }
 
 bool SpellInfo::HasAreaAuraEffect() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].IsAreaAuraEffect())
-            return true;
-    return false;
+    return _hasAreaAuraEffect;
 }
 
 bool SpellInfo::IsExplicitDiscovery() const
@@ -2043,10 +2029,7 @@ Mechanics SpellInfo::GetEffectMechanic(uint8 effIndex) const
 
 bool SpellInfo::HasAnyEffectMechanic() const
 {
-    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-        if (Effects[i].Mechanic)
-            return true;
-    return false;
+    return (_effectMechanicMask & ~uint32(1 << MECHANIC_NONE)) != 0;
 }
 
 uint32 SpellInfo::GetDispelMask() const
@@ -2633,6 +2616,34 @@ void SpellInfo::_InitializeExplicitTargetMask()
     ExplicitTargetMask = targetMask;
 }
 
+void SpellInfo::_InitializeEffectMasks()
+{
+    _effectMask.reset();
+    _auraTypeMask.reset();
+    _effectMechanicMask = 0;
+    _hasAnyAura = false;
+    _hasAreaAuraEffect = false;
+
+    for (SpellEffectInfo const& effect : Effects)
+    {
+        if (effect.Effect < TOTAL_SPELL_EFFECTS)
+            _effectMask.set(effect.Effect);
+
+        if (effect.Mechanic < MAX_MECHANIC)
+            _effectMechanicMask |= 1 << effect.Mechanic;
+
+        if (effect.IsAura())
+        {
+            _hasAnyAura = true;
+            if (effect.ApplyAuraName < TOTAL_AURAS)
+                _auraTypeMask.set(effect.ApplyAuraName);
+        }
+
+        if (effect.IsAreaAuraEffect())
+            _hasAreaAuraEffect = true;
+    }
+}
+
 bool SpellInfo::_IsPositiveEffect(uint8 effIndex, bool deep) const
 {
     // not found a single positive spell with this attribute
@@ -23,6 +23,7 @@
 #include "SharedDefines.h"
 #include "SpellAuraDefines.h"
 #include "Util.h"
+#include <bitset>
 
 class Unit;
 class Player;
@@ -378,10 +379,6 @@ public:
     std::array<uint32, 2> TotemCategory;
     std::array<uint32, 2> SpellVisual;
     uint32 SpellIconID;
-    uint32 ActiveIconID;
-    uint32 SpellPriority;
-    std::array<char const*, 16> SpellName;
-    std::array<char const*, 16> Rank;
     uint32 MaxTargetLevel;
     uint32 MaxAffectedTargets;
     uint32 SpellFamilyName;
@@ -402,6 +399,20 @@ public:
     bool _isCritCapable;
     bool _requireCooldownInfo;
 
+    // 由各效果预先计算的掩码，HasEffect/HasAura 等查询只需测试对应的位
+    // 修改 Effects 之后需要调用 _InitializeEffectMasks 重新计算
+    std::bitset<TOTAL_SPELL_EFFECTS> _effectMask;
+    std::bitset<TOTAL_AURAS> _auraTypeMask;
+    uint32 _effectMechanicMask;
+    bool _hasAnyAura;
+    bool _hasAreaAuraEffect;
+
+    // rarely used on the combat paths, kept behind the hot fields
+    std::array<char const*, 16> SpellName;
+    std::array<char const*, 16> Rank;
+    uint32 ActiveIconID;
+    uint32 SpellPriority;
+
     SpellInfo(SpellEntry const* spellEntry);
     ~SpellInfo();
 
@@ -529,6 +540,7 @@ public:
 
     // loading helpers
     void _InitializeExplicitTargetMask();
+    void _InitializeEffectMasks();
     bool _IsPositiveEffect(uint8 effIndex, bool deep) const;
     bool _IsPositiveSpell() const;
     static bool _IsPositiveTarget(uint32 targetA, uint32 targetB);
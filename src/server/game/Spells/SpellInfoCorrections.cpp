@@ -5145,6 +5145,9 @@ void SpellMgr::LoadSpellInfoCorrections()
             continue;
         }
 
+        // effects may have been changed by the fixes above
+        spellInfo->_InitializeEffectMasks();
+
         for (uint8 j = 0; j < MAX_SPELL_EFFECTS; ++j)
         {
             switch (spellInfo->Effects[j].Effect)
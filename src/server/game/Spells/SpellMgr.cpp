@@ -1739,6 +1739,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++mProcDataGeneration;                                  // units rebuild their proc aura index
 
     //                                                0      1           2                3                 4                 5                 6          7       8          9             10       11
     QueryResult result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, procFlags, procEx, procPhase, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -1833,6 +1834,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++mProcDataGeneration;                             // units rebuild their proc aura index
 
     //                                                 0        1           2                3                 4                 5                 6          7              8              9         10              11             12      13        14
     QueryResult result = WorldDatabase.Query("SELECT SpellId, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, ProcFlags, SpellTypeMask, SpellPhaseMask, HitMask, AttributesMask, ProcsPerMinute, Chance, Cooldown, Charges FROM spell_proc");
@@ -2691,11 +2693,27 @@ void SpellMgr::LoadSpellInfoStore()
 {
     uint32 oldMSTime = getMSTime();
 
+    // the store is shared by all map threads once the world is running, it can not be rebuilt anymore
+    ASSERT(!mSpellInfoStoreFrozen, "SpellInfo store can not be reloaded after it was frozen");
+
     UnloadSpellInfoStore();
+    // mSpellInfoMap stays sparse and indexed by the raw spell id: about 20 callers walk
+    // 0..GetSpellInfoStoreSize() and pass the loop index as a spell id, and SpellInfo::Id
+    // is used as a key all over the core. Only the objects themselves are packed densely.
     mSpellInfoMap.resize(sSpellStore.GetNumRows(), nullptr);
 
+    // construct every SpellInfo in place in one contiguous block,
+    // SpellEffectInfo keeps a pointer to its SpellInfo so the block must never reallocate
+    std::size_t spellCount = 0;
+    for (SpellEntry const* spellEntry : sSpellStore)
+        if (spellEntry)
+            ++spellCount;
+
+    mSpellInfoStore.reserve(spellCount);
     for (SpellEntry const* spellEntry : sSpellStore)
-        mSpellInfoMap[spellEntry->Id] = new SpellInfo(spellEntry);
+        mSpellInfoMap[spellEntry->Id] = &mSpellInfoStore.emplace_back(spellEntry);
+
+    ASSERT(mSpellInfoStore.capacity() == spellCount);
 
     for (uint32 spellIndex = 0; spellIndex < GetSpellInfoStoreSize(); ++spellIndex)
     {
@@ -2760,10 +2778,8 @@ SpellCooldownOverride SpellMgr::GetSpellCooldownOverride(uint32 spellId) const
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
-        delete mSpellInfoMap[i];
-
     mSpellInfoMap.clear();
+    std::vector<SpellInfo>().swap(mSpellInfoStore);
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -3447,6 +3463,7 @@ void SpellMgr::LoadSpellInfoCustomAttributes()
         }
 
         spellInfo->_InitializeExplicitTargetMask();
+        spellInfo->_InitializeEffectMasks();
 
         if (sSpellMgr->HasSpellCooldownOverride(spellInfo->Id))
         {
@@ -693,6 +693,8 @@ public:
     // Spell proc table
     [[nodiscard]] SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
     bool CanSpellTriggerProcOnEvent(SpellProcEntry const& procEntry, ProcEventInfo& eventInfo) const;
+    // 触发数据（spell_proc_event、spell_proc）的版本，每次加载后递增
+    [[nodiscard]] uint32 GetProcDataGeneration() const { return mProcDataGeneration; }
 
     // Spell bonus data table
     [[nodiscard]] SpellBonusEntry const* GetSpellBonusData(uint32 spellId) const;
@@ -750,6 +752,10 @@ public:
     }
     [[nodiscard]] uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
 
+    // 冻结 SpellInfo 存储，之后不允许再重建，所有地图线程持有的 SpellInfo 指针在关服前一直有效
+    void FreezeSpellInfoStore() { mSpellInfoStoreFrozen = true; }
+    [[nodiscard]] bool IsSpellInfoStoreFrozen() const { return mSpellInfoStoreFrozen; }
+
     // Talent Additional Set
     [[nodiscard]] bool IsAdditionalTalentSpell(uint32 spellId) const;
 
@@ -802,6 +808,7 @@ private:
     SpellGroupStackMap         mSpellGroupStackMap;
     SpellProcEventMap          mSpellProcEventMap;
     SpellProcMap               mSpellProcMap;
+    uint32                     mProcDataGeneration = 0;
     SpellBonusMap              mSpellBonusMap;
     SpellThreatMap             mSpellThreatMap;
     SpellMixologyMap           mSpellMixologyMap;
@@ -817,7 +824,9 @@ private:
     SkillLineAbilityMap        mSkillLineAbilityMap;
     PetLevelupSpellMap         mPetLevelupSpellMap;
     PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
-    SpellInfoMap               mSpellInfoMap;
+    SpellInfoMap               mSpellInfoMap;                  // spell id -> entry of mSpellInfoStore
+    std::vector<SpellInfo>     mSpellInfoStore;                // all SpellInfo objects in one block, ordered by spell id
+    bool                       mSpellInfoStoreFrozen{false};
     SpellCooldownOverrideMap   mSpellCooldownOverrideMap;
     TalentAdditionalSet        mTalentSpellAdditionalSet;
 };
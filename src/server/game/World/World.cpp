@@ -42,6 +42,7 @@
 #include "CreatureGroups.h"
 #include "CreatureTextMgr.h"
 #include "DBCStores.h"
+#include "DataManifest.h"
 #include "DatabaseEnv.h"
 #include "DisableMgr.h"
 #include "DynamicVisibility.h"
@@ -72,6 +73,7 @@
 #include "PlayerDump.h"
 #include "PoolMgr.h"
 #include "Realm.h"
+#include "ScriptHookProfiler.h"
 #include "ScriptMgr.h"
 #include "ServerMailMgr.h"
 #include "SkillDiscovery.h"
@@ -189,6 +191,10 @@ void World::LoadConfigSettings(bool reload)
 
     _worldConfig.Initialize(reload);
 
+    // on reload keep whatever .server hookprofile start/stop left running
+    if (!reload)
+        sScriptHookProfiler->SetEnabled(getBoolConfig(CONFIG_SCRIPT_HOOK_PROFILER));
+
     for (uint8 i = 0; i < MAX_MOVE_TYPE; ++i)
         playerBaseMoveSpeed[i] = baseMoveSpeed[i] * getRate(RATE_MOVESPEED_PLAYER);
 
@@ -341,6 +347,35 @@ void World::SetInitialWorldSettings()
             LOG_ERROR("server.loading", "Failed to find map files for starting areas");
             exit(1);
         }
+
+        ///- Check the map files against the manifests written by the extractors
+        if (uint32 verifyMode = getIntConfig(CONFIG_DATA_MANIFEST_VERIFY))
+        {
+            uint32 mismatches = 0;
+            for (char const* directory : { "maps", "vmaps" })
+            {
+                std::string path = Acore::StringFormat("{}{}", _dataPath, directory);
+                DataManifest manifest;
+                if (!manifest.Load(Acore::StringFormat("{}/{}", path, DataManifest::FILE_NAME)))
+                {
+                    LOG_WARN("server.loading", "No data manifest found in {}, re-run the extractors to create it", path);
+                    continue;
+                }
+
+                std::vector<std::string> errors;
+                mismatches += manifest.Verify(path, verifyMode > 1, errors);
+                for (std::string const& error : errors)
+                    LOG_ERROR("server.loading", "Data manifest: {}", error);
+
+                LOG_INFO("server.loading", "Verified {} files in {}", manifest.GetSize(), path);
+            }
+
+            if (mismatches)
+            {
+                LOG_ERROR("server.loading", "{} map files do not match the data manifests, re-extract the data", mismatches);
+                exit(1);
+            }
+        }
     }
 
     ///- Initialize pool manager
@@ -428,6 +463,7 @@ void World::SetInitialWorldSettings()
 
     LOG_INFO("server.loading", "Loading SpellInfo Custom Attributes...");
     sSpellMgr->LoadSpellInfoCustomAttributes();
+    sSpellMgr->FreezeSpellInfoStore();
 
     LOG_INFO("server.loading", "Loading Player Totem models...");
     sObjectMgr->LoadPlayerTotemModels();
@@ -1323,6 +1359,7 @@ void World::Update(uint32 diff)
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update metrics"));
         // Stats logger update
+        sScriptHookProfiler->Update(diff);
         sMetric->Update();
         METRIC_VALUE("update_time_diff", diff);
     }
@@ -164,6 +164,7 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<uint32>(CONFIG_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value < MAX_LEVEL; }, "< MAX_LEVEL");
 
     SetConfigValue<uint32>(CONFIG_INTERVAL_MAPUPDATE, "MapUpdateInterval", 10, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value >= MIN_MAP_UPDATE_DELAY; }, ">= MIN_MAP_UPDATE_DELAY");
+    SetConfigValue<uint32>(CONFIG_INTERVAL_MAPUPDATE_REDUCED_RATE, "MapUpdate.ReducedRateInterval", 0);
 
     SetConfigValue<uint32>(CONFIG_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 600000);
 
@@ -566,6 +567,10 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_PDUMP_NO_PATHS, "PlayerDump.DisallowPaths", true);
     SetConfigValue<bool>(CONFIG_PDUMP_NO_OVERWRITE, "PlayerDump.DisallowOverwrite", true);
     SetConfigValue<bool>(CONFIG_ENABLE_MMAPS, "MoveMaps.Enable", true);
+    SetConfigValue<bool>(CONFIG_ASYNC_PATHFINDING, "MoveMaps.AsyncPathfinding.Enable", false);
+    SetConfigValue<uint32>(CONFIG_ASYNC_PATHFINDING_THREADS, "MoveMaps.AsyncPathfinding.Threads", 2);
+    SetConfigValue<uint32>(CONFIG_ASYNC_PATHFINDING_TICK_BUDGET, "MoveMaps.AsyncPathfinding.TickBudget", 1000);
+    SetConfigValue<uint32>(CONFIG_DATA_MANIFEST_VERIFY, "DataManifest.Verify", 0);
 
     // Wintergrasp
     SetConfigValue<uint32>(CONFIG_WINTERGRASP_ENABLE, "Wintergrasp.Enable", 1);
@@ -651,6 +656,12 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SPELL_QUEUE_ENABLED, "SpellQueue.Enabled", true);
     SetConfigValue<uint32>(CONFIG_SPELL_QUEUE_WINDOW, "SpellQueue.Window", 400);
 
+    SetConfigValue<bool>(CONFIG_BATCH_PERIODIC_AURA_LOG, "CombatLog.BatchPeriodicAuraLog", false);
+    SetConfigValue<bool>(CONFIG_COMBAT_LOG_DISPATCHER, "CombatLog.Dispatcher.Enable", false);
+    SetConfigValue<uint32>(CONFIG_COMBAT_LOG_OBSERVER_BYTES_PER_SECOND, "CombatLog.Dispatcher.ObserverBytesPerSecond", 0);
+
+    SetConfigValue<bool>(CONFIG_SCRIPT_HOOK_PROFILER, "Script.HookProfiler.Enable", false);
+
     SetConfigValue<uint32>(CONFIG_SUNSREACH_COUNTER_MAX, "Sunsreach.CounterMax", 10000);
 
     SetConfigValue<std::string>(CONFIG_NEW_CHAR_STRING, "PlayerStart.String", "");
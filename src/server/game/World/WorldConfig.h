@@ -98,6 +98,7 @@ enum ServerConfigs
     CONFIG_PDUMP_NO_PATHS,
     CONFIG_PDUMP_NO_OVERWRITE,
     CONFIG_ENABLE_MMAPS,
+    CONFIG_ASYNC_PATHFINDING,
     CONFIG_ENABLE_LOGIN_AFTER_DC,
     CONFIG_DONT_CACHE_RANDOM_MOVEMENT_PATHS,
     CONFIG_QUEST_IGNORE_AUTO_ACCEPT,
@@ -141,6 +142,9 @@ enum ServerConfigs
     CONFIG_MUNCHING_BLIZZLIKE,
     CONFIG_ENABLE_DAZE,
     CONFIG_SPELL_QUEUE_ENABLED,
+    CONFIG_BATCH_PERIODIC_AURA_LOG,
+    CONFIG_COMBAT_LOG_DISPATCHER,
+    CONFIG_SCRIPT_HOOK_PROFILER,
     CONFIG_GROUP_XP_DISTANCE,
     CONFIG_MAX_RECRUIT_A_FRIEND_DISTANCE,
     CONFIG_SIGHT_MONSTER,
@@ -159,6 +163,7 @@ enum ServerConfigs
     CONFIG_RESPAWN_DYNAMICRATE_CREATURE,
     CONFIG_COMPRESSION,
     CONFIG_INTERVAL_MAPUPDATE,
+    CONFIG_INTERVAL_MAPUPDATE_REDUCED_RATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
     CONFIG_INTERVAL_SAVE,
@@ -291,6 +296,9 @@ enum ServerConfigs
     CONFIG_PVP_TOKEN_COUNT,
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_NUMTHREADS,
+    CONFIG_ASYNC_PATHFINDING_THREADS,
+    CONFIG_ASYNC_PATHFINDING_TICK_BUDGET,
+    CONFIG_DATA_MANIFEST_VERIFY,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR,
@@ -374,6 +382,7 @@ enum ServerConfigs
     CONFIG_DAILY_RBG_MIN_LEVEL_AP_REWARD,
     CONFIG_AUCTIONHOUSE_WORKERTHREADS,
     CONFIG_SPELL_QUEUE_WINDOW,
+    CONFIG_COMBAT_LOG_OBSERVER_BYTES_PER_SECOND,
     CONFIG_SUNSREACH_COUNTER_MAX,
     CONFIG_RESPAWN_DYNAMICMINIMUM_GAMEOBJECT,
     CONFIG_RESPAWN_DYNAMICMINIMUM_CREATURE,
@@ -139,8 +139,8 @@ public:
         handler->PSendSysMessage("gridloc [{}, {}]", gridCoord.x_coord, gridCoord.y_coord);
 
         // calculate navmesh tile location
-        dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId(), player->GetInstanceId());
+        MMAP::NavMeshQueryHandle navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->AcquireNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId());
+        dtNavMesh const* navmesh = navmeshquery.GetNavMesh();
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
@@ -191,8 +191,8 @@ public:
     static bool HandleMmapLoadedTilesCommand(ChatHandler* handler)
     {
         uint32 mapid = handler->GetSession()->GetPlayer()->GetMapId();
-        dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(mapid);
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapid, handler->GetSession()->GetPlayer()->GetInstanceId());
+        MMAP::NavMeshQueryHandle navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->AcquireNavMeshQuery(mapid);
+        dtNavMesh const* navmesh = navmeshquery.GetNavMesh();
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
@@ -255,6 +255,13 @@ public:
         handler->PSendSysMessage(" {} polygons ({} vertices)", polyCount, vertCount);
         handler->PSendSysMessage(" {} triangles ({} vertices)", triCount, triVertCount);
         handler->PSendSysMessage(" {} MB of data (not including pointers)", ((float)dataSize / sizeof(unsigned char)) / 1048576);
+        handler->PSendSysMessage(" {} pooled navmesh queries", manager->getNavMeshQueryCount(handler->GetSession()->GetPlayer()->GetMapId()));
+
+        MMAP::PathCacheStats cacheStats = manager->getPathCacheStats(handler->GetSession()->GetPlayer()->GetMapId());
+        handler->PSendSysMessage("Path cache stats:");
+        handler->PSendSysMessage(" {} cached paths, cleared {} times", cacheStats.size, cacheStats.invalidations);
+        handler->PSendSysMessage(" {} hits, {} misses ({:.1f}% hit rate)", cacheStats.hits, cacheStats.misses, cacheStats.GetHitRate() * 100.0f);
+        handler->PSendSysMessage(" {} us saved per hit on average", cacheStats.GetAverageSavedMicros());
 
         return true;
     }
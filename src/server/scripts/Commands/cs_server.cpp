@@ -25,6 +25,7 @@
 #include "MotdMgr.h"
 #include "MySQLThreading.h"
 #include "Realm.h"
+#include "ScriptHookProfiler.h"
 #include "StringConvert.h"
 #include "UpdateTime.h"
 #include "VMapFactory.h"
@@ -69,6 +70,14 @@ public:
             { "",             HandleServerShutDownCommand,       SEC_ADMINISTRATOR, Console::Yes }
         };
 
+        static ChatCommandTable serverHookProfileCommandTable =
+        {
+            { "start",        HandleServerHookProfileStartCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "stop",         HandleServerHookProfileStopCommand,  SEC_ADMINISTRATOR, Console::Yes },
+            { "reset",        HandleServerHookProfileResetCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "show",         HandleServerHookProfileShowCommand,  SEC_ADMINISTRATOR, Console::Yes }
+        };
+
         static ChatCommandTable serverSetCommandTable =
         {
             { "loglevel",     HandleServerSetLogLevelCommand,    SEC_CONSOLE,       Console::Yes },
@@ -81,6 +90,7 @@ public:
             { "corpses",      HandleServerCorpsesCommand,        SEC_GAMEMASTER,    Console::Yes },
             { "debug",        HandleServerDebugCommand,          SEC_ADMINISTRATOR, Console::Yes },
             { "exit",         HandleServerExitCommand,           SEC_CONSOLE,       Console::Yes },
+            { "hookprofile",  serverHookProfileCommandTable },
             { "idlerestart",  serverIdleRestartCommandTable },
             { "idleshutdown", serverIdleShutdownCommandTable },
             { "info",         HandleServerInfoCommand,           SEC_PLAYER,        Console::Yes },
@@ -601,6 +611,49 @@ public:
         sLog->SetLogLevel(name, level, isLogger);
         return true;
     }
+
+    // Start counting the calls and the time of the script hooks
+    static bool HandleServerHookProfileStartCommand(ChatHandler* handler)
+    {
+        sScriptHookProfiler->SetEnabled(true);
+        handler->SendSysMessage("Script hook profiler started.");
+        return true;
+    }
+
+    static bool HandleServerHookProfileStopCommand(ChatHandler* handler)
+    {
+        sScriptHookProfiler->SetEnabled(false);
+        handler->SendSysMessage("Script hook profiler stopped, the results are kept until reset.");
+        return true;
+    }
+
+    static bool HandleServerHookProfileResetCommand(ChatHandler* handler)
+    {
+        sScriptHookProfiler->Reset();
+        handler->SendSysMessage("Script hook profiler results cleared.");
+        return true;
+    }
+
+    // Show the most expensive script hooks since the last reset
+    static bool HandleServerHookProfileShowCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        std::vector<ScriptHookProfiler::HookStats> stats = sScriptHookProfiler->GetStats(count.value_or(10));
+        if (stats.empty())
+        {
+            handler->SendSysMessage("No script hook calls recorded.");
+            return true;
+        }
+
+        handler->PSendSysMessage("Script hook profiler ({}):", ScriptHookProfiler::IsEnabled() ? "running" : "stopped");
+        for (ScriptHookProfiler::HookStats const& hook : stats)
+        {
+            uint64 const totalUs = std::chrono::duration_cast<std::chrono::microseconds>(hook.Time).count();
+            handler->PSendSysMessage("{} {}: {} calls, {} us total, {} us average", hook.ScriptName, hook.HookName,
+                hook.Calls, totalUs, hook.Calls ? totalUs / hook.Calls : 0);
+        }
+
+        return true;
+    }
 };
 
 void AddSC_server_commandscript()
@@ -41,7 +41,7 @@ struct npc_preparations_for_war_vehicle : public NullCreatureAI
 
     void InitializeAI() override
     {
-        WPPath* path = sSmartWaypointMgr->GetPath(me->GetEntry());
+        WPPath const* path = sSmartWaypointMgr->GetPath(me->GetEntry());
         if (!path || path->empty())
         {
             me->DespawnOrUnsummon(1);
@@ -52,12 +52,8 @@ struct npc_preparations_for_war_vehicle : public NullCreatureAI
         pathPoints.push_back(G3D::Vector3(me->GetPositionX(), me->GetPositionY(), me->GetPositionZ()));
 
         uint32 wpCounter = 1;
-        WPPath::const_iterator itr;
-        while ((itr = path->find(wpCounter++)) != path->end())
-        {
-            WayPoint* wp = itr->second;
+        while (WayPoint const* wp = path->GetPoint(wpCounter++))
             pathPoints.push_back(G3D::Vector3(wp->x, wp->y, wp->z));
-        }
 
         me->GetMotionMaster()->MoveSplinePath(&pathPoints);
 
@@ -1314,7 +1314,7 @@ public:
                     break;
                 case EVENT_START_FLIGHT:
                     {
-                        WPPath* path = sSmartWaypointMgr->GetPath(me->GetEntry());
+                        WPPath const* path = sSmartWaypointMgr->GetPath(me->GetEntry());
                         if (!path || path->empty())
                         {
                             me->DespawnOrUnsummon(1);
@@ -1325,12 +1325,8 @@ public:
                         pathPoints.push_back(G3D::Vector3(me->GetPositionX(), me->GetPositionY(), me->GetPositionZ()));
 
                         uint32 wpCounter = 1;
-                        WPPath::const_iterator itr;
-                        while ((itr = path->find(wpCounter++)) != path->end())
-                        {
-                            WayPoint* wp = itr->second;
+                        while (WayPoint const* wp = path->GetPoint(wpCounter++))
                             pathPoints.push_back(G3D::Vector3(wp->x, wp->y, wp->z));
-                        }
 
                         me->GetMotionMaster()->MoveSplinePath(&pathPoints);
                         events.ScheduleEvent(EVENT_CHECK_PATH_REGEN_HEALTH_BURN_DAMAGE, 1min);
@@ -0,0 +1,299 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Config.h"
+#include "DetourNavMeshBuilder.h"
+#include "DetourNavMeshQuery.h"
+#include "MMapMgr.h"
+#include "MapDefines.h"
+#include "gtest/gtest.h"
+
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 TEST_MAP_ID = 1;
+    constexpr int32 GRID_CELLS = 8;     // quads per side of the test tile
+    constexpr float CELL_SIZE = 4.0f;   // world units per quad
+    constexpr uint32 WORKER_COUNT = 8;
+    constexpr uint32 QUERIES_PER_WORKER = 2000;
+    constexpr uint32 TILE_RELOADS = 50;
+    constexpr int32 MAX_TEST_PATH = 74;
+
+    // builds a single flat tile made of GRID_CELLS x GRID_CELLS quads
+    std::vector<unsigned char> BuildFlatTile()
+    {
+        std::vector<unsigned short> verts;
+        for (int32 z = 0; z <= GRID_CELLS; ++z)
+            for (int32 x = 0; x <= GRID_CELLS; ++x)
+            {
+                verts.push_back(uint16(x));
+                verts.push_back(0);
+                verts.push_back(uint16(z));
+            }
+
+        auto vertIndex = [](int32 x, int32 z) { return uint16(z * (GRID_CELLS + 1) + x); };
+        auto polyIndex = [](int32 x, int32 z) -> uint16
+        {
+            if (x < 0 || z < 0 || x >= GRID_CELLS || z >= GRID_CELLS)
+                return 0xffff; // tile border
+            return uint16(z * GRID_CELLS + x);
+        };
+
+        int32 const nvp = 6;
+        std::vector<unsigned short> polys;
+        for (int32 z = 0; z < GRID_CELLS; ++z)
+            for (int32 x = 0; x < GRID_CELLS; ++x)
+            {
+                unsigned short poly[nvp * 2];
+                std::fill(std::begin(poly), std::end(poly), 0xffff);
+                poly[0] = vertIndex(x, z);
+                poly[1] = vertIndex(x, z + 1);
+                poly[2] = vertIndex(x + 1, z + 1);
+                poly[3] = vertIndex(x + 1, z);
+                poly[nvp + 0] = polyIndex(x - 1, z);
+                poly[nvp + 1] = polyIndex(x, z + 1);
+                poly[nvp + 2] = polyIndex(x + 1, z);
+                poly[nvp + 3] = polyIndex(x, z - 1);
+                polys.insert(polys.end(), std::begin(poly), std::end(poly));
+            }
+
+        std::vector<unsigned short> flags(GRID_CELLS * GRID_CELLS, NAV_GROUND);
+        std::vector<unsigned char> areas(GRID_CELLS * GRID_CELLS, 0);
+
+        dtNavMeshCreateParams params;
+        memset(&params, 0, sizeof(params));
+        params.verts = verts.data();
+        params.vertCount = int32(verts.size() / 3);
+        params.polys = polys.data();
+        params.polyFlags = flags.data();
+        params.polyAreas = areas.data();
+        params.polyCount = GRID_CELLS * GRID_CELLS;
+        params.nvp = nvp;
+        params.walkableHeight = 2.0f;
+        params.walkableRadius = 0.5f;
+        params.walkableClimb = 1.0f;
+        params.bmin[0] = 0.0f;
+        params.bmin[1] = 0.0f;
+        params.bmin[2] = 0.0f;
+        params.bmax[0] = GRID_CELLS * CELL_SIZE;
+        params.bmax[1] = 1.0f;
+        params.bmax[2] = GRID_CELLS * CELL_SIZE;
+        params.cs = CELL_SIZE;
+        params.ch = 1.0f;
+        params.buildBvTree = true;
+
+        unsigned char* data = nullptr;
+        int32 dataSize = 0;
+        if (!dtCreateNavMeshData(&params, &data, &dataSize))
+            return {};
+
+        std::vector<unsigned char> tile(data, data + dataSize);
+        dtFree(data);
+        return tile;
+    }
+}
+
+class MMapMgrTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        dataDir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("mmaptest-%%%%%%");
+        boost::filesystem::create_directories(dataDir / "mmaps");
+
+        dtNavMeshParams params;
+        memset(&params, 0, sizeof(params));
+        params.tileWidth = GRID_CELLS * CELL_SIZE;
+        params.tileHeight = GRID_CELLS * CELL_SIZE;
+        params.maxTiles = 4;
+        params.maxPolys = 256;
+
+        std::ofstream mapFile((dataDir / "mmaps" / "001.mmap").string(), std::ios::binary);
+        mapFile.write(reinterpret_cast<char const*>(&params), sizeof(params));
+        mapFile.close();
+
+        std::vector<unsigned char> tile = BuildFlatTile();
+        ASSERT_FALSE(tile.empty());
+
+        MmapTileHeader header;
+        header.size = uint32(tile.size());
+        std::ofstream tileFile((dataDir / "mmaps" / "0010000.mmtile").string(), std::ios::binary);
+        tileFile.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        tileFile.write(reinterpret_cast<char const*>(tile.data()), tile.size());
+        tileFile.close();
+
+        confFilePath = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("mmaptest-%%%%%%.conf")).string();
+        std::ofstream confFile(confFilePath);
+        confFile << "[test]\n";
+        confFile << "DataDir = \"" << dataDir.string() << "\"\n";
+        confFile.close();
+
+        sConfigMgr->Configure(confFilePath, std::vector<std::string>());
+        sConfigMgr->LoadAppConfigs();
+    }
+
+    void TearDown() override
+    {
+        std::remove(confFilePath.c_str());
+        boost::filesystem::remove_all(dataDir);
+    }
+
+    boost::filesystem::path dataDir;
+    std::string confFilePath;
+};
+
+TEST_F(MMapMgrTest, AcquireWithoutNavMesh)
+{
+    MMAP::MMapMgr mgr;
+    MMAP::NavMeshQueryHandle query = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+    EXPECT_FALSE(query);
+    EXPECT_EQ(query.GetNavMesh(), nullptr);
+}
+
+TEST_F(MMapMgrTest, QueriesAreReused)
+{
+    MMAP::MMapMgr mgr;
+    ASSERT_TRUE(mgr.loadMap(TEST_MAP_ID, 0, 0));
+
+    for (uint32 i = 0; i < 10; ++i)
+    {
+        MMAP::NavMeshQueryHandle query = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+        ASSERT_TRUE(query);
+        EXPECT_EQ(query.GetNavMesh(), mgr.GetNavMesh(TEST_MAP_ID));
+    }
+
+    EXPECT_EQ(mgr.getNavMeshQueryCount(TEST_MAP_ID), 1u);
+
+    MMAP::NavMeshQueryHandle first = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+    MMAP::NavMeshQueryHandle second = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(mgr.getNavMeshQueryCount(TEST_MAP_ID), 2u);
+
+    // moved-from handles must not return their query twice
+    MMAP::NavMeshQueryHandle moved = std::move(first);
+    EXPECT_FALSE(first);
+    moved.Release();
+    second.Release();
+    EXPECT_EQ(mgr.getNavMeshQueryCount(TEST_MAP_ID), 2u);
+
+    EXPECT_TRUE(mgr.unloadMap(TEST_MAP_ID));
+}
+
+TEST_F(MMapMgrTest, PathCacheClearedOnTileReload)
+{
+    MMAP::MMapMgr mgr;
+    ASSERT_TRUE(mgr.loadMap(TEST_MAP_ID, 0, 0));
+
+    {
+        MMAP::NavMeshQueryHandle query = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+        ASSERT_TRUE(query);
+        ASSERT_NE(query.GetPathCache(), nullptr);
+
+        dtPolyRef const path[] = { 1, 2 };
+        query.GetPathCache()->Insert({ 1, 2, NAV_GROUND, 0 }, path, 2, 10);
+    }
+
+    EXPECT_EQ(mgr.getPathCacheStats(TEST_MAP_ID).size, 1u);
+
+    EXPECT_TRUE(mgr.unloadMap(TEST_MAP_ID, 0, 0));
+    MMAP::PathCacheStats stats = mgr.getPathCacheStats(TEST_MAP_ID);
+    EXPECT_EQ(stats.size, 0u);
+    EXPECT_EQ(stats.invalidations, 1u);
+
+    EXPECT_TRUE(mgr.loadMap(TEST_MAP_ID, 0, 0));
+    EXPECT_TRUE(mgr.unloadMap(TEST_MAP_ID));
+}
+
+TEST_F(MMapMgrTest, ConcurrentPathQueriesWithTileReload)
+{
+    MMAP::MMapMgr mgr;
+    ASSERT_TRUE(mgr.loadMap(TEST_MAP_ID, 0, 0));
+
+    std::atomic<uint32> pathsFound{0};
+    std::atomic<uint32> pathFailures{0};
+    std::atomic<bool> workersDone{false};
+
+    // detour coordinates are (y, z, x) in game space, the test tile is flat at height 0
+    float const start[3] = { 1.0f, 0.0f, 1.0f };
+    float const end[3] = { GRID_CELLS * CELL_SIZE - 1.0f, 0.0f, GRID_CELLS * CELL_SIZE - 1.0f };
+    float const extents[3] = { 3.0f, 5.0f, 3.0f };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 0; i < WORKER_COUNT; ++i)
+    {
+        workers.emplace_back([&]()
+        {
+            dtQueryFilterExt filter;
+            dtPolyRef path[MAX_TEST_PATH];
+
+            for (uint32 n = 0; n < QUERIES_PER_WORKER; ++n)
+            {
+                MMAP::NavMeshQueryHandle query = mgr.AcquireNavMeshQuery(TEST_MAP_ID);
+                if (!query)
+                {
+                    ++pathFailures;
+                    continue;
+                }
+
+                dtPolyRef startRef = 0;
+                dtPolyRef endRef = 0;
+                query->findNearestPoly(start, extents, &filter, &startRef, nullptr);
+                query->findNearestPoly(end, extents, &filter, &endRef, nullptr);
+
+                // tile is being reloaded, nothing to path on
+                if (startRef == 0 || endRef == 0)
+                    continue;
+
+                int32 pathLength = 0;
+                dtStatus status = query->findPath(startRef, endRef, start, end, &filter, path, &pathLength, MAX_TEST_PATH);
+                if (dtStatusSucceed(status) && !dtStatusDetail(status, DT_PARTIAL_RESULT) && pathLength > 0 && path[pathLength - 1] == endRef)
+                    ++pathsFound;
+                else
+                    ++pathFailures;
+            }
+        });
+    }
+
+    std::thread reloader([&]()
+    {
+        for (uint32 i = 0; i < TILE_RELOADS && !workersDone; ++i)
+        {
+            EXPECT_TRUE(mgr.unloadMap(TEST_MAP_ID, 0, 0));
+            EXPECT_TRUE(mgr.loadMap(TEST_MAP_ID, 0, 0));
+            std::this_thread::yield();
+        }
+    });
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    workersDone = true;
+    reloader.join();
+
+    EXPECT_EQ(pathFailures, 0u);
+    EXPECT_GT(pathsFound, 0u);
+    EXPECT_LE(mgr.getNavMeshQueryCount(TEST_MAP_ID), WORKER_COUNT);
+    EXPECT_EQ(mgr.getLoadedTilesCount(), 1u);
+
+    EXPECT_TRUE(mgr.unloadMap(TEST_MAP_ID));
+}
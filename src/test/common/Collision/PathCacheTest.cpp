@@ -0,0 +1,98 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "gtest/gtest.h"
+
+using namespace MMAP;
+
+namespace
+{
+    PathCacheKey MakeKey(dtPolyRef start, dtPolyRef end, uint16 include = 1, uint16 exclude = 0)
+    {
+        return { start, end, include, exclude };
+    }
+}
+
+TEST(PathCacheTest, HitReturnsStoredPath)
+{
+    PathCache cache(4);
+    dtPolyRef const path[] = { 1, 2, 3 };
+    cache.Insert(MakeKey(1, 3), path, 3, 50);
+
+    dtPolyRef result[8] = {};
+    uint32 length = 0;
+    ASSERT_TRUE(cache.Find(MakeKey(1, 3), result, length, 8));
+    EXPECT_EQ(length, 3u);
+    EXPECT_EQ(result[0], 1u);
+    EXPECT_EQ(result[2], 3u);
+
+    // different filter flags are different paths
+    EXPECT_FALSE(cache.Find(MakeKey(1, 3, 1, 2), result, length, 8));
+    // cached path does not fit the output buffer
+    EXPECT_FALSE(cache.Find(MakeKey(1, 3), result, length, 2));
+
+    PathCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.GetAverageSavedMicros(), 50u);
+}
+
+TEST(PathCacheTest, EvictsLeastRecentlyUsed)
+{
+    PathCache cache(2);
+    dtPolyRef const path[] = { 1, 2 };
+    dtPolyRef result[8];
+    uint32 length = 0;
+
+    cache.Insert(MakeKey(1, 2), path, 2, 10);
+    cache.Insert(MakeKey(3, 4), path, 2, 10);
+    ASSERT_TRUE(cache.Find(MakeKey(1, 2), result, length, 8));
+
+    cache.Insert(MakeKey(5, 6), path, 2, 10);
+    EXPECT_TRUE(cache.Find(MakeKey(1, 2), result, length, 8));
+    EXPECT_FALSE(cache.Find(MakeKey(3, 4), result, length, 8));
+    EXPECT_TRUE(cache.Find(MakeKey(5, 6), result, length, 8));
+    EXPECT_EQ(cache.GetStats().size, 2u);
+}
+
+TEST(PathCacheTest, InvalidateClearsEntries)
+{
+    PathCache cache(4);
+    dtPolyRef const path[] = { 1, 2 };
+    dtPolyRef result[8];
+    uint32 length = 0;
+
+    cache.Insert(MakeKey(1, 2), path, 2, 10);
+    cache.Invalidate();
+
+    EXPECT_FALSE(cache.Find(MakeKey(1, 2), result, length, 8));
+    EXPECT_EQ(cache.GetStats().size, 0u);
+    EXPECT_EQ(cache.GetStats().invalidations, 1u);
+}
+
+TEST(PathCacheTest, DisabledCacheStoresNothing)
+{
+    PathCache cache(0);
+    dtPolyRef const path[] = { 1, 2 };
+    dtPolyRef result[8];
+    uint32 length = 0;
+
+    EXPECT_FALSE(cache.IsEnabled());
+    cache.Insert(MakeKey(1, 2), path, 2, 10);
+    EXPECT_FALSE(cache.Find(MakeKey(1, 2), result, length, 8));
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DataManifest.h"
+#include "gtest/gtest.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace
+{
+    class DataManifestTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("manifest-%%%%%%%%");
+            boost::filesystem::create_directories(_directory);
+        }
+
+        void TearDown() override
+        {
+            boost::filesystem::remove_all(_directory);
+        }
+
+        std::string WriteFile(std::string const& name, std::string const& content)
+        {
+            std::string path = (_directory / name).string();
+            std::ofstream(path, std::ios::binary) << content;
+            return path;
+        }
+
+        DataManifest::Entry MakeEntry(std::string const& path, std::string const& sourceHash)
+        {
+            DataManifest::Entry entry;
+            entry.Size = boost::filesystem::file_size(path);
+            entry.Hash = DataManifest::HashFile(path);
+            entry.SourceHash = sourceHash;
+            return entry;
+        }
+
+        boost::filesystem::path _directory;
+    };
+}
+
+TEST_F(DataManifestTest, SaveAndLoad)
+{
+    DataManifest manifest;
+    manifest.Set("0001020.map", MakeEntry(WriteFile("0001020.map", "terrain"), "abcd"));
+    manifest.Set("000.vmtree", MakeEntry(WriteFile("000.vmtree", "tree"), ""));
+
+    std::string manifestPath = (_directory / DataManifest::FILE_NAME).string();
+    ASSERT_TRUE(manifest.Save(manifestPath));
+
+    DataManifest loaded;
+    ASSERT_TRUE(loaded.Load(manifestPath));
+    EXPECT_EQ(loaded.GetSize(), 2u);
+
+    DataManifest::Entry const* entry = loaded.Find("0001020.map");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->Size, 7u);
+    EXPECT_EQ(entry->Hash, DataManifest::HashData(reinterpret_cast<uint8 const*>("terrain"), 7));
+    EXPECT_EQ(entry->SourceHash, "abcd");
+
+    ASSERT_NE(loaded.Find("000.vmtree"), nullptr);
+    EXPECT_TRUE(loaded.Find("000.vmtree")->SourceHash.empty());
+    EXPECT_EQ(loaded.Find("missing.map"), nullptr);
+}
+
+TEST_F(DataManifestTest, LoadRejectsOtherFiles)
+{
+    DataManifest manifest;
+    EXPECT_FALSE(manifest.Load((_directory / "none.txt").string()));
+    EXPECT_FALSE(manifest.Load(WriteFile("other.txt", "0001020.map 7 abcd -\n")));
+}
+
+TEST_F(DataManifestTest, VerifyDetectsChangedFiles)
+{
+    DataManifest manifest;
+    manifest.Set("a.map", MakeEntry(WriteFile("a.map", "aaaa"), ""));
+    manifest.Set("b.map", MakeEntry(WriteFile("b.map", "bbbb"), ""));
+    manifest.Set("c.map", MakeEntry(WriteFile("c.map", "cccc"), ""));
+
+    std::vector<std::string> errors;
+    EXPECT_EQ(manifest.Verify(_directory.string(), true, errors), 0u);
+    EXPECT_TRUE(errors.empty());
+
+    WriteFile("a.map", "aaaaa");                // size changed
+    WriteFile("b.map", "xxxx");                 // same size, content changed
+    boost::filesystem::remove(_directory / "c.map");
+
+    EXPECT_EQ(manifest.Verify(_directory.string(), false, errors), 2u);
+    errors.clear();
+    EXPECT_EQ(manifest.Verify(_directory.string(), true, errors), 3u);
+    EXPECT_EQ(errors.size(), 3u);
+}
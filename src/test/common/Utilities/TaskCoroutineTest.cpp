@@ -0,0 +1,160 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskCoroutine.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+    // Sets the flag when the coroutine frame holding it is destroyed
+    struct DestroyedFlag
+    {
+        bool& Destroyed;
+        ~DestroyedFlag() { Destroyed = true; }
+    };
+
+    TaskCoroutine Sequence(std::vector<uint32>& steps)
+    {
+        steps.push_back(1);
+        co_await TaskCoroutine::Wait(Milliseconds(100));
+        steps.push_back(2);
+        co_await TaskCoroutine::Wait(Milliseconds(100));
+        steps.push_back(3);
+    }
+
+    TaskCoroutine WaitForSignal(TaskSignal& signal, std::vector<uint32>& steps, bool& destroyed)
+    {
+        DestroyedFlag flag{ destroyed };
+        steps.push_back(1);
+        co_await signal;
+        steps.push_back(2);
+        co_await signal;
+        steps.push_back(3);
+    }
+
+    TaskCoroutine WaitForCondition(bool const& condition, uint32& checks, std::vector<uint32>& steps)
+    {
+        co_await TaskCoroutine::WaitUntil(Milliseconds(50), [&condition, &checks]()
+        {
+            ++checks;
+            return condition;
+        });
+        steps.push_back(1);
+    }
+}
+
+TEST(TaskCoroutineTest, WaitResumesOnTime)
+{
+    std::vector<uint32> steps;
+    TaskScheduler scheduler;
+    scheduler.Start(Sequence(steps));
+    EXPECT_TRUE(steps.empty());
+
+    scheduler.Update(Milliseconds(0));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+
+    scheduler.Update(Milliseconds(60));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+
+    // the waits count from when they were due, a late update catches up with both
+    scheduler.Update(Milliseconds(200));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1, 2, 3 }));
+}
+
+TEST(TaskCoroutineTest, SignalWakesWaiters)
+{
+    std::vector<uint32> steps;
+    bool destroyed = false;
+    TaskSignal signal;
+    TaskScheduler scheduler;
+    scheduler.Start(1, WaitForSignal(signal, steps, destroyed));
+
+    scheduler.Update(Milliseconds(10));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+    EXPECT_TRUE(signal.HasWaiters());
+    EXPECT_TRUE(scheduler.IsGroupScheduled(1));
+
+    // parked waiters are not touched by rescheduling
+    scheduler.RescheduleGroup(1, Milliseconds(0));
+    scheduler.Update(Milliseconds(1000));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+
+    signal.Notify();
+    EXPECT_FALSE(signal.HasWaiters());
+    scheduler.Update(Milliseconds(10));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1, 2 }));
+
+    signal.Notify();
+    scheduler.Update(Milliseconds(10));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1, 2, 3 }));
+    EXPECT_TRUE(destroyed);
+    EXPECT_FALSE(scheduler.IsGroupScheduled(1));
+}
+
+TEST(TaskCoroutineTest, CancelDestroysFrame)
+{
+    std::vector<uint32> steps;
+    bool destroyed = false;
+    TaskSignal signal;
+    TaskScheduler scheduler;
+    scheduler.Start(1, WaitForSignal(signal, steps, destroyed));
+    scheduler.Update(Milliseconds(10));
+
+    scheduler.CancelGroup(1);
+    EXPECT_TRUE(destroyed);
+    EXPECT_FALSE(signal.HasWaiters());
+
+    // nothing is left to resume
+    signal.Notify();
+    scheduler.Update(Milliseconds(10));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+
+    destroyed = false;
+    {
+        TaskScheduler owner;
+        owner.Start(WaitForSignal(signal, steps, destroyed));
+        owner.Update(Milliseconds(10));
+        EXPECT_FALSE(destroyed);
+    }
+
+    EXPECT_TRUE(destroyed);
+    signal.Notify();
+}
+
+TEST(TaskCoroutineTest, WaitUntilCondition)
+{
+    std::vector<uint32> steps;
+    uint32 checks = 0;
+    bool condition = false;
+    TaskScheduler scheduler;
+    scheduler.Start(WaitForCondition(condition, checks, steps));
+
+    // checked when awaited, a late update does not catch up on the missed intervals
+    scheduler.Update(Milliseconds(200));
+    EXPECT_TRUE(steps.empty());
+    EXPECT_EQ(checks, 1u);
+
+    condition = true;
+    scheduler.Update(Milliseconds(20));
+    EXPECT_TRUE(steps.empty());
+    EXPECT_EQ(checks, 1u);
+    scheduler.Update(Milliseconds(30));
+    EXPECT_EQ(steps, (std::vector<uint32>{ 1 }));
+    EXPECT_EQ(checks, 2u);
+}
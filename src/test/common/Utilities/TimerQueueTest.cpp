@@ -0,0 +1,290 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "EventProcessor.h"
+#include "TaskScheduler.h"
+#include "TimerQueue.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    class CountingEvent : public BasicEvent
+    {
+    public:
+        CountingEvent(std::vector<uint32>& executed, uint32 id) : _executed(executed), _id(id) { }
+
+        bool Execute(uint64, uint32) override
+        {
+            _executed.push_back(_id);
+            return true;
+        }
+
+    private:
+        std::vector<uint32>& _executed;
+        uint32 _id;
+    };
+
+    // The per object timer churn of a busy map: every owner keeps a few timers, reschedules some
+    // of them, cancels some and runs the due ones every update
+    struct TimerChurn
+    {
+        static constexpr uint32 OWNERS = 2000;
+        static constexpr uint32 TIMERS_PER_OWNER = 8;
+        static constexpr uint32 UPDATES = 200;
+        static constexpr uint32 UPDATE_DIFF = 50;
+
+        template<class Schedule, class Cancel, class Update>
+        static double Run(Schedule schedule, Cancel cancel, Update update)
+        {
+            std::mt19937 random(11);
+            auto start = std::chrono::steady_clock::now();
+
+            for (uint32 owner = 0; owner < OWNERS; ++owner)
+                for (uint32 timer = 0; timer < TIMERS_PER_OWNER; ++timer)
+                    schedule(owner, timer + 1, 500 + random() % 5000);
+
+            for (uint32 tick = 0; tick < UPDATES; ++tick)
+            {
+                for (uint32 owner = 0; owner < OWNERS; ++owner)
+                {
+                    uint32 const roll = random() % 16;
+                    if (roll == 0)
+                        cancel(owner, 1 + random() % TIMERS_PER_OWNER);
+                    else if (roll == 1)
+                        schedule(owner, 1 + random() % TIMERS_PER_OWNER, 500 + random() % 5000);
+
+                    update(owner, UPDATE_DIFF);
+                }
+            }
+
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            return double(OWNERS) * UPDATES / std::max(elapsed.count(), 1e-9);
+        }
+    };
+
+    // EventMap as it was before TimerQueue, only the baseline of DISABLED_TimerChurnPerSecond
+    class MultimapEventMap
+    {
+    public:
+        void ScheduleEvent(uint32 eventId, uint32 time) { _eventMap.emplace(_time + time, eventId); }
+
+        void CancelEvent(uint32 eventId)
+        {
+            for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+            {
+                if (eventId == itr->second)
+                    itr = _eventMap.erase(itr);
+                else
+                    ++itr;
+            }
+        }
+
+        void Update(uint32 time) { _time += time; }
+
+        uint32 ExecuteEvent()
+        {
+            if (_eventMap.empty() || _eventMap.begin()->first > _time)
+                return 0;
+
+            uint32 eventId = _eventMap.begin()->second;
+            _eventMap.erase(_eventMap.begin());
+            return eventId;
+        }
+
+    private:
+        uint32 _time{ 0 };
+        std::multimap<uint32, uint32> _eventMap;
+    };
+
+    template<class Map>
+    double RunEventMapChurn()
+    {
+        std::vector<Map> maps(TimerChurn::OWNERS);
+        return TimerChurn::Run(
+            [&](uint32 owner, uint32 eventId, uint32 time) { maps[owner].ScheduleEvent(eventId, time); },
+            [&](uint32 owner, uint32 eventId) { maps[owner].CancelEvent(eventId); },
+            [&](uint32 owner, uint32 diff)
+            {
+                Map& events = maps[owner];
+                events.Update(diff);
+                while (uint32 eventId = events.ExecuteEvent())
+                    events.ScheduleEvent(eventId, 500 + eventId * 250);
+            });
+    }
+}
+
+TEST(TimerQueueTest, SameOrderAsMultimap)
+{
+    std::mt19937 random(3);
+    TimerQueue<uint32, uint32> queue;
+    std::multimap<uint32, uint32> reference;
+
+    for (uint32 round = 0; round < 20000; ++round)
+    {
+        uint32 const roll = random() % 10;
+        if (roll < 6 || reference.empty())
+        {
+            // few distinct times, so many values share one
+            uint32 time = random() % 64;
+            queue.Push(time, round);
+            reference.emplace(time, round);
+        }
+        else if (roll < 9)
+        {
+            ASSERT_EQ(queue.Top().time, reference.begin()->first);
+            ASSERT_EQ(queue.Pop(), reference.begin()->second);
+            reference.erase(reference.begin());
+        }
+        else
+        {
+            uint32 removed = random() % 7;
+            queue.RemoveIf([removed](TimerQueue<uint32, uint32>::Node const& node) { return node.value % 7 == removed; });
+            for (auto itr = reference.begin(); itr != reference.end();)
+                itr = itr->second % 7 == removed ? reference.erase(itr) : std::next(itr);
+        }
+
+        ASSERT_EQ(queue.Size(), reference.size());
+    }
+
+    while (!reference.empty())
+    {
+        ASSERT_EQ(queue.Pop(), reference.begin()->second);
+        reference.erase(reference.begin());
+    }
+
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(TimerQueueTest, ExtractKeepsQueueOrder)
+{
+    TimerQueue<uint32, uint32> queue;
+    for (uint32 i = 0; i < 32; ++i)
+        queue.Push(i % 4, i);
+
+    std::vector<TimerQueue<uint32, uint32>::Node> extracted;
+    queue.ExtractIf([](TimerQueue<uint32, uint32>::Node const& node) { return node.value % 2 == 0; }, extracted);
+
+    ASSERT_EQ(extracted.size(), 16u);
+    for (std::size_t i = 1; i < extracted.size(); ++i)
+        EXPECT_TRUE(extracted[i - 1] < extracted[i]);
+
+    // nodes put back keep their place among the values due at the same time
+    queue.Reinsert(extracted[1]);
+    queue.Reinsert(extracted[0]);
+    EXPECT_EQ(queue.Pop(), 0u);
+    EXPECT_EQ(queue.Pop(), 4u);
+    EXPECT_EQ(queue.Pop(), 1u);
+}
+
+TEST(TimerQueueTest, EventMapOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 100);
+    events.ScheduleEvent(2, 100, 1);
+    events.ScheduleEvent(3, 50, 1);
+    events.ScheduleEvent(4, 100);
+
+    EXPECT_EQ(events.GetNextEventTime(), 50u);
+    EXPECT_EQ(events.GetNextEventTime(4), 100u);
+
+    // the delayed events are queued behind the events already due at their new time
+    events.DelayEvents(50, 1);
+    events.Update(150);
+    EXPECT_EQ(events.ExecuteEvent(), 1u);
+    EXPECT_EQ(events.ExecuteEvent(), 4u);
+    EXPECT_EQ(events.ExecuteEvent(), 3u);
+    EXPECT_EQ(events.ExecuteEvent(), 2u);
+    EXPECT_EQ(events.ExecuteEvent(), 0u);
+
+    events.ScheduleEvent(5, 10);
+    events.ScheduleEvent(6, 10, 2);
+    events.CancelEventGroup(2);
+    events.CancelEvent(7);
+    EXPECT_EQ(events.GetTimeUntilEvent(5), Milliseconds(10));
+    EXPECT_EQ(events.GetTimeUntilEvent(6), Milliseconds::max());
+}
+
+TEST(TimerQueueTest, EventProcessorOrder)
+{
+    std::vector<uint32> executed;
+    EventProcessor events;
+    for (uint32 i = 0; i < 6; ++i)
+        events.AddEventAtOffset(new CountingEvent(executed, i), Milliseconds(i % 2 ? 100 : 200));
+
+    BasicEvent* moved = new CountingEvent(executed, 6);
+    events.AddEventAtOffset(moved, Milliseconds(300));
+    events.ModifyEventTime(moved, Milliseconds(100));
+
+    events.Update(100);
+    EXPECT_EQ(executed, (std::vector<uint32>{ 1, 3, 5, 6 }));
+
+    events.Update(100);
+    EXPECT_EQ(executed, (std::vector<uint32>{ 1, 3, 5, 6, 0, 2, 4 }));
+}
+
+TEST(TimerQueueTest, TaskSchedulerOrder)
+{
+    std::vector<uint32> executed;
+    TaskScheduler scheduler;
+    scheduler.Schedule(Milliseconds(20), 1, [&](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(Milliseconds(10), [&](TaskContext) { executed.push_back(2); });
+    scheduler.Schedule(Milliseconds(10), 1, [&](TaskContext) { executed.push_back(3); });
+    scheduler.DelayGroup(1, Milliseconds(20));
+
+    EXPECT_TRUE(scheduler.IsGroupScheduled(1));
+    scheduler.Update(Milliseconds(100));
+    EXPECT_EQ(executed, (std::vector<uint32>{ 2, 3, 1 }));
+    EXPECT_FALSE(scheduler.IsGroupScheduled(1));
+}
+
+// Micro benchmark: schedule, cancel and update churn of many small per object timer sets.
+// Disabled so the unit test run does not time anything, run it on demand with
+// --gtest_also_run_disabled_tests --gtest_filter=TimerQueueTest.DISABLED_TimerChurnPerSecond
+TEST(TimerQueueTest, DISABLED_TimerChurnPerSecond)
+{
+    double multimapRate = RunEventMapChurn<MultimapEventMap>();
+    double queueRate = RunEventMapChurn<EventMap>();
+
+    std::vector<uint32> executed;
+    executed.reserve(1 << 20);
+    std::vector<EventProcessor> processors(TimerChurn::OWNERS);
+    double processorRate = TimerChurn::Run(
+        [&](uint32 owner, uint32 id, uint32 time) { processors[owner].AddEventAtOffset(new CountingEvent(executed, id), Milliseconds(time)); },
+        [&](uint32 owner, uint32) { processors[owner].CancelEventGroup(0); },
+        [&](uint32 owner, uint32 diff)
+        {
+            processors[owner].Update(diff);
+            if (executed.size() > (1 << 19))
+                executed.clear();
+        });
+
+    EXPECT_GT(queueRate, 0.0);
+
+    std::cout << "[ BENCH    ] " << TimerChurn::OWNERS << " owners: multimap EventMap " << uint64(multimapRate)
+        << " updates/s, TimerQueue EventMap " << uint64(queueRate) << " updates/s, EventProcessor "
+        << uint64(processorRate) << " updates/s" << std::endl;
+    RecordProperty("MultimapEventMapUpdatesPerSecond", std::to_string(uint64(multimapRate)));
+    RecordProperty("TimerQueueEventMapUpdatesPerSecond", std::to_string(uint64(queueRate)));
+    RecordProperty("EventProcessorUpdatesPerSecond", std::to_string(uint64(processorRate)));
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CombatLogDispatcher.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    ObjectGuid const PLAYER = ObjectGuid::Create<HighGuid::Player>(1);
+    ObjectGuid const OTHER_PLAYER = ObjectGuid::Create<HighGuid::Player>(2);
+    ObjectGuid const PET = ObjectGuid::Create<HighGuid::Pet>(10, 1);
+    ObjectGuid const VEHICLE = ObjectGuid::Create<HighGuid::Vehicle>(20, 2);
+    ObjectGuid const CREATURE = ObjectGuid::Create<HighGuid::Unit>(30, 3);
+
+    // 50 bytes on the wire with the packet header
+    uint32 const ENTRY_SIZE = 50;
+
+    CombatLogEntry MakeEntry(ObjectGuid const& attacker, ObjectGuid const& attackerOwner, ObjectGuid const& victim, ObjectGuid const& victimOwner)
+    {
+        WorldPacket packet;
+        packet.resize(ENTRY_SIZE - 4);
+        return CombatLogEntry(attacker, attacker, attackerOwner, victim, victimOwner, std::move(packet));
+    }
+}
+
+TEST(CombatLogDispatcherTest, AttackerAndVictimAreInvolved)
+{
+    CombatLogEntry entry = MakeEntry(PLAYER, ObjectGuid::Empty, CREATURE, ObjectGuid::Empty);
+    EXPECT_TRUE(entry.Involves(PLAYER));
+    EXPECT_TRUE(entry.Involves(CREATURE));
+    EXPECT_FALSE(entry.Involves(OTHER_PLAYER));
+}
+
+TEST(CombatLogDispatcherTest, OwnersAreInvolved)
+{
+    // the player's pet hits a creature, the player sees it as their own log
+    CombatLogEntry petAttack = MakeEntry(PET, PLAYER, CREATURE, ObjectGuid::Empty);
+    EXPECT_TRUE(petAttack.Involves(PLAYER));
+    EXPECT_FALSE(petAttack.Involves(OTHER_PLAYER));
+
+    // a creature hits the vehicle the player drives
+    CombatLogEntry vehicleHit = MakeEntry(CREATURE, ObjectGuid::Empty, VEHICLE, PLAYER);
+    EXPECT_TRUE(vehicleHit.Involves(PLAYER));
+    EXPECT_FALSE(vehicleHit.Involves(OTHER_PLAYER));
+
+    // units without an owner do not make the empty guid part of the log
+    EXPECT_FALSE(vehicleHit.Involves(ObjectGuid::Empty));
+}
+
+TEST(CombatLogDispatcherTest, BystanderBudgetPerObserver)
+{
+    CombatLogObserverBudget budget;
+    budget.Update(0);
+
+    CombatLogEntry entry = MakeEntry(CREATURE, ObjectGuid::Empty, VEHICLE, ObjectGuid::Empty);
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, 2 * ENTRY_SIZE));
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, 2 * ENTRY_SIZE));
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, 2 * ENTRY_SIZE));
+
+    // every observer has a budget of its own
+    EXPECT_TRUE(budget.Consume(OTHER_PLAYER, entry, 2 * ENTRY_SIZE));
+
+    // no budget configured, nothing is dropped
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, 0));
+}
+
+TEST(CombatLogDispatcherTest, InvolvedObserversIgnoreBudget)
+{
+    CombatLogObserverBudget budget;
+    budget.Update(0);
+
+    CombatLogEntry bystander = MakeEntry(CREATURE, ObjectGuid::Empty, VEHICLE, ObjectGuid::Empty);
+    EXPECT_TRUE(budget.Consume(PLAYER, bystander, ENTRY_SIZE));
+    EXPECT_FALSE(budget.Consume(PLAYER, bystander, ENTRY_SIZE));
+
+    // the player's own fight and the fights of their pet and vehicle still reach them
+    EXPECT_TRUE(budget.Consume(PLAYER, MakeEntry(PLAYER, ObjectGuid::Empty, CREATURE, ObjectGuid::Empty), ENTRY_SIZE));
+    EXPECT_TRUE(budget.Consume(PLAYER, MakeEntry(PET, PLAYER, CREATURE, ObjectGuid::Empty), ENTRY_SIZE));
+    EXPECT_TRUE(budget.Consume(PLAYER, MakeEntry(CREATURE, ObjectGuid::Empty, VEHICLE, PLAYER), ENTRY_SIZE));
+
+    // and do not use up the budget of the player
+    EXPECT_FALSE(budget.Consume(PLAYER, bystander, ENTRY_SIZE));
+
+    // another player near the pet is only a bystander
+    EXPECT_TRUE(budget.Consume(OTHER_PLAYER, MakeEntry(PET, PLAYER, CREATURE, ObjectGuid::Empty), ENTRY_SIZE));
+    EXPECT_FALSE(budget.Consume(OTHER_PLAYER, MakeEntry(PET, PLAYER, CREATURE, ObjectGuid::Empty), ENTRY_SIZE));
+}
+
+TEST(CombatLogDispatcherTest, BudgetWindowIsOneSecond)
+{
+    CombatLogObserverBudget budget;
+    budget.Update(1000);
+
+    CombatLogEntry entry = MakeEntry(CREATURE, ObjectGuid::Empty, VEHICLE, ObjectGuid::Empty);
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+
+    // later updates within the same second keep the used bytes
+    budget.Update(1500);
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+    budget.Update(1999);
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+
+    // a new window starts one second after the last one
+    budget.Update(2000);
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+
+    // the window is counted from the update that started it, not in fixed steps
+    budget.Update(3500);
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+    budget.Update(4400);
+    EXPECT_FALSE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+    budget.Update(4500);
+    EXPECT_TRUE(budget.Consume(PLAYER, entry, ENTRY_SIZE));
+}
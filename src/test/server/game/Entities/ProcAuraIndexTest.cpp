@@ -0,0 +1,205 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProcAuraIndex.h"
+#include "SpellMgr.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    struct TestAura
+    {
+        uint32 SpellId = 0;
+    };
+
+    typedef ProcAuraIndex<TestAura> TestIndex;
+
+    struct TestProcEvent
+    {
+        uint32 ProcFlags;
+        uint32 ProcPhase;
+    };
+
+    // A raid buffed unit: many auras, only a few of them can proc
+    class ProcAuraIndexTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 random(42);
+            uint32 const procFlagChoices[] =
+            {
+                PROC_FLAG_DONE_MELEE_AUTO_ATTACK,
+                PROC_FLAG_TAKEN_MELEE_AUTO_ATTACK | PROC_FLAG_TAKEN_SPELL_MELEE_DMG_CLASS,
+                PROC_FLAG_DONE_SPELL_MAGIC_DMG_CLASS_NEG,
+                PROC_FLAG_DONE_PERIODIC,
+                PROC_FLAG_KILL,
+            };
+
+            _auras.resize(AURA_COUNT);
+            for (uint32 i = 0; i < AURA_COUNT; ++i)
+            {
+                // duplicated spell ids, the index must keep their insertion order
+                _auras[i].SpellId = 1000 + (i % 48);
+                _applied.insert(std::make_pair(_auras[i].SpellId, &_auras[i]));
+
+                TestIndex::Candidate candidate;
+                candidate.Application = &_auras[i];
+                if (i % 8 == 0)
+                {
+                    candidate.ProcFlags = procFlagChoices[random() % std::size(procFlagChoices)];
+                    candidate.ProcPhases = (candidate.ProcFlags & PROC_FLAG_KILL) ? 0 : uint32(PROC_SPELL_PHASE_HIT);
+                }
+
+                // proc data of every applied aura, the way the old loop looked it up per event
+                _procData[&_auras[i]] = candidate;
+                if (candidate.ProcFlags)
+                    _index.Insert(_auras[i].SpellId, candidate);
+            }
+
+            uint32 const eventFlags[] =
+            {
+                PROC_FLAG_DONE_MELEE_AUTO_ATTACK,
+                PROC_FLAG_TAKEN_MELEE_AUTO_ATTACK,
+                PROC_FLAG_DONE_SPELL_MAGIC_DMG_CLASS_NEG,
+                PROC_FLAG_TAKEN_SPELL_MAGIC_DMG_CLASS_POS,
+                PROC_FLAG_DONE_PERIODIC,
+            };
+            uint32 const eventPhases[] = { PROC_SPELL_PHASE_CAST, PROC_SPELL_PHASE_HIT, PROC_SPELL_PHASE_HIT, PROC_SPELL_PHASE_FINISH };
+            for (uint32 i = 0; i < 1024; ++i)
+                _events.push_back({ eventFlags[random() % std::size(eventFlags)], eventPhases[random() % std::size(eventPhases)] });
+        }
+
+        // Candidates of an event by checking every applied aura
+        std::vector<TestAura*> ScanApplied(TestProcEvent const& event) const
+        {
+            std::vector<TestAura*> result;
+            for (auto const& [spellId, aura] : _applied)
+                if (_procData.at(aura).Matches(event.ProcFlags, event.ProcPhase))
+                    result.push_back(aura);
+            return result;
+        }
+
+        // Candidates of an event from the index
+        std::vector<TestAura*> ScanIndex(TestProcEvent const& event) const
+        {
+            std::vector<TestAura*> result;
+            if (!_index.HasCandidates(event.ProcFlags))
+                return result;
+
+            for (auto const& [spellId, candidate] : _index)
+                if (candidate.Matches(event.ProcFlags, event.ProcPhase))
+                    result.push_back(candidate.Application);
+            return result;
+        }
+
+        static constexpr uint32 AURA_COUNT = 64;
+
+        std::vector<TestAura> _auras;
+        std::multimap<uint32, TestAura*> _applied;
+        std::unordered_map<TestAura const*, TestIndex::Candidate> _procData;
+        TestIndex _index;
+        std::vector<TestProcEvent> _events;
+    };
+}
+
+TEST_F(ProcAuraIndexTest, SameCandidatesAsFullScan)
+{
+    EXPECT_EQ(_index.GetSize(), AURA_COUNT / 8);
+
+    for (TestProcEvent const& event : _events)
+        EXPECT_EQ(ScanIndex(event), ScanApplied(event));
+}
+
+TEST_F(ProcAuraIndexTest, RemoveUpdatesFlags)
+{
+    TestIndex index;
+    TestAura first{ 1 }, second{ 1 }, third{ 2 };
+
+    TestIndex::Candidate candidate;
+    candidate.ProcFlags = PROC_FLAG_DONE_MELEE_AUTO_ATTACK;
+    candidate.ProcPhases = PROC_SPELL_PHASE_HIT;
+
+    candidate.Application = &first;
+    index.Insert(first.SpellId, candidate);
+    candidate.Application = &second;
+    index.Insert(second.SpellId, candidate);
+    candidate.Application = &third;
+    candidate.ProcFlags = PROC_FLAG_KILL;
+    candidate.ProcPhases = 0;
+    index.Insert(third.SpellId, candidate);
+
+    EXPECT_EQ(index.GetProcFlags(), uint32(PROC_FLAG_DONE_MELEE_AUTO_ATTACK | PROC_FLAG_KILL));
+    EXPECT_TRUE(index.begin()->second.Matches(PROC_FLAG_DONE_MELEE_AUTO_ATTACK, PROC_SPELL_PHASE_HIT));
+    EXPECT_FALSE(index.begin()->second.Matches(PROC_FLAG_DONE_MELEE_AUTO_ATTACK, PROC_SPELL_PHASE_CAST));
+    EXPECT_TRUE(std::prev(index.end())->second.Matches(PROC_FLAG_KILL, PROC_SPELL_PHASE_NONE));
+
+    // the flag stays while one aura still has it
+    index.Remove(first.SpellId, &first);
+    EXPECT_TRUE(index.HasCandidates(PROC_FLAG_DONE_MELEE_AUTO_ATTACK));
+    EXPECT_EQ(index.begin()->second.Application, &second);
+
+    index.Remove(second.SpellId, &second);
+    EXPECT_FALSE(index.HasCandidates(PROC_FLAG_DONE_MELEE_AUTO_ATTACK));
+    EXPECT_TRUE(index.HasCandidates(PROC_FLAG_KILL));
+
+    // removing an aura that is not indexed does nothing
+    index.Remove(first.SpellId, &first);
+    EXPECT_EQ(index.GetSize(), 1u);
+
+    candidate.Application = &first;
+    candidate.ProcFlags = 0;
+    candidate.AlwaysCheck = true;
+    index.Insert(first.SpellId, candidate);
+    EXPECT_TRUE(index.HasCandidates(PROC_FLAG_TAKEN_DAMAGE));
+}
+
+// Micro benchmark: proc events per second of a heavily buffed unit, full scan against the index.
+// Disabled so the unit test run does not time anything, run it on demand with
+// --gtest_also_run_disabled_tests --gtest_filter=ProcAuraIndexTest.DISABLED_ProcsPerSecond
+TEST_F(ProcAuraIndexTest, DISABLED_ProcsPerSecond)
+{
+    uint32 const rounds = 200;
+
+    auto measure = [&](auto scan)
+    {
+        std::size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 round = 0; round < rounds; ++round)
+            for (TestProcEvent const& event : _events)
+                found += scan(event).size();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return std::make_pair(found, double(rounds * _events.size()) / std::max(elapsed.count(), 1e-9));
+    };
+
+    auto [scanFound, scanRate] = measure([this](TestProcEvent const& event) { return ScanApplied(event); });
+    auto [indexFound, indexRate] = measure([this](TestProcEvent const& event) { return ScanIndex(event); });
+
+    EXPECT_EQ(scanFound, indexFound);
+
+    std::cout << "[ BENCH    ] " << AURA_COUNT << " applied auras, " << _index.GetSize() << " proc auras: full scan "
+        << uint64(scanRate) << " procs/s, index " << uint64(indexRate) << " procs/s" << std::endl;
+    RecordProperty("FullScanProcsPerSecond", std::to_string(uint64(scanRate)));
+    RecordProperty("IndexProcsPerSecond", std::to_string(uint64(indexRate)));
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridDefines.h"
+#include "GridTerrainData.h"
+#include "gtest/gtest.h"
+
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    float const GRID_MIN_HEIGHT = -20.0f;
+    float const GRID_MAX_HEIGHT = 300.0f;
+
+    uint16 V9Value(uint32 x, uint32 y) { return uint16((x * 131 + y * 977) % 65536); }
+    uint16 V8Value(uint32 x, uint32 y) { return uint16((x * 389 + y * 53) % 65536); }
+
+    // Height of a uint16 map the way it was sampled before the storage was interleaved
+    float ReferenceHeight(float x, float y)
+    {
+        x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
+        y = MAP_RESOLUTION * (32 - y / SIZE_OF_GRIDS);
+
+        int x_int = (int)x;
+        int y_int = (int)y;
+        x -= x_int;
+        y -= y_int;
+        x_int &= (MAP_RESOLUTION - 1);
+        y_int &= (MAP_RESOLUTION - 1);
+
+        int32 h1 = V9Value(x_int, y_int);
+        int32 h2 = V9Value(x_int + 1, y_int);
+        int32 h3 = V9Value(x_int, y_int + 1);
+        int32 h4 = V9Value(x_int + 1, y_int + 1);
+        int32 h5 = 2 * V8Value(x_int, y_int);
+
+        int32 a, b, c;
+        if (x + y < 1)
+        {
+            if (x > y) { a = h2 - h1; b = h5 - h1 - h2; c = h1; }
+            else { a = h5 - h1 - h3; b = h3 - h1; c = h1; }
+        }
+        else
+        {
+            if (x > y) { a = h2 + h4 - h5; b = h4 - h2; c = h5 - h4; }
+            else { a = h4 - h3; b = h3 + h4 - h5; c = h5 - h4; }
+        }
+
+        float multiplier = (GRID_MAX_HEIGHT - GRID_MIN_HEIGHT) / 65535;
+        return (float)((a * x) + (b * y) + c) * multiplier + GRID_MIN_HEIGHT;
+    }
+
+    class GridTerrainDataTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("grid-%%%%%%%%.map")).string();
+            FILE* file = fopen(_fileName.c_str(), "wb");
+            ASSERT_NE(file, nullptr);
+
+            std::vector<uint16> v9(129 * 129), v8(128 * 128);
+            for (uint32 x = 0; x < 129; ++x)
+                for (uint32 y = 0; y < 129; ++y)
+                    v9[x * 129 + y] = V9Value(x, y);
+            for (uint32 x = 0; x < 128; ++x)
+                for (uint32 y = 0; y < 128; ++y)
+                    v8[x * 128 + y] = V8Value(x, y);
+
+            // liquid covering the whole grid with three different levels
+            std::vector<float> liquid(128 * 128);
+            for (uint32 i = 0; i < liquid.size(); ++i)
+                liquid[i] = 10.0f + float(i % 3);
+
+            // one hole in cell 2, 3
+            std::array<uint16, 16 * 16> holes = { };
+            holes[2 * 16 + 3] = 0x0020;
+
+            map_fileheader header = { };
+            header.mapMagic = MapMagic.asUInt;
+            header.versionMagic = MapVersionMagic;
+            header.areaMapOffset = sizeof(header);
+            header.areaMapSize = sizeof(map_areaHeader);
+            header.heightMapOffset = header.areaMapOffset + header.areaMapSize;
+            header.heightMapSize = sizeof(map_heightHeader) + (v9.size() + v8.size()) * sizeof(uint16);
+            header.liquidMapOffset = header.heightMapOffset + header.heightMapSize;
+            header.liquidMapSize = sizeof(map_liquidHeader) + liquid.size() * sizeof(float);
+            header.holesOffset = header.liquidMapOffset + header.liquidMapSize;
+            header.holesSize = sizeof(holes);
+
+            map_areaHeader areaHeader = { MapAreaMagic.asUInt, MAP_AREA_NO_AREA, 12 };
+            map_heightHeader heightHeader = { MapHeightMagic.asUInt, MAP_HEIGHT_AS_INT16, GRID_MIN_HEIGHT, GRID_MAX_HEIGHT };
+            map_liquidHeader liquidHeader = { MapLiquidMagic.asUInt, MAP_LIQUID_NO_TYPE, MAP_LIQUID_TYPE_WATER, 0, 0, 0, 128, 128, 0.0f };
+
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(&areaHeader, sizeof(areaHeader), 1, file);
+            fwrite(&heightHeader, sizeof(heightHeader), 1, file);
+            fwrite(v9.data(), sizeof(uint16), v9.size(), file);
+            fwrite(v8.data(), sizeof(uint16), v8.size(), file);
+            fwrite(&liquidHeader, sizeof(liquidHeader), 1, file);
+            fwrite(liquid.data(), sizeof(float), liquid.size(), file);
+            fwrite(holes.data(), sizeof(holes), 1, file);
+            fclose(file);
+
+            ASSERT_EQ(_terrain.Load(_fileName), TerrainMapDataReadResult::Success);
+        }
+
+        void TearDown() override
+        {
+            boost::filesystem::remove(_fileName);
+        }
+
+        std::string _fileName;
+        GridTerrainData _terrain;
+    };
+}
+
+TEST_F(GridTerrainDataTest, HeightsMatchReference)
+{
+    std::vector<float> xs, ys;
+    for (float x = 1.3f; x < SIZE_OF_GRIDS - 1.0f; x += 7.77f)
+    {
+        for (float y = 2.1f; y < SIZE_OF_GRIDS - 1.0f; y += 5.31f)
+        {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+
+    std::vector<float> heights(xs.size());
+    _terrain.getHeights(xs.data(), ys.data(), heights.data(), uint32(xs.size()));
+
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+        float height = _terrain.getHeight(xs[i], ys[i]);
+        EXPECT_EQ(heights[i], height);
+
+        if (height != INVALID_HEIGHT)
+            EXPECT_FLOAT_EQ(height, ReferenceHeight(xs[i], ys[i]));
+    }
+}
+
+TEST_F(GridTerrainDataTest, HoleBits)
+{
+    // hole bit 5 of cell 2, 3 is hole row 1 and column 1 of that cell, so squares 18-19, 26-27
+    auto squareCenter = [](uint32 square) { return (32.0f - (float(square) + 0.5f) / MAP_RESOLUTION) * SIZE_OF_GRIDS; };
+
+    EXPECT_EQ(_terrain.getHeight(squareCenter(18), squareCenter(26)), INVALID_HEIGHT);
+    EXPECT_EQ(_terrain.getHeight(squareCenter(19), squareCenter(27)), INVALID_HEIGHT);
+    EXPECT_NE(_terrain.getHeight(squareCenter(17), squareCenter(26)), INVALID_HEIGHT);
+    EXPECT_NE(_terrain.getHeight(squareCenter(18), squareCenter(28)), INVALID_HEIGHT);
+}
+
+TEST_F(GridTerrainDataTest, LiquidLevels)
+{
+    auto squareCenter = [](uint32 square) { return (32.0f - (float(square) + 0.5f) / MAP_RESOLUTION) * SIZE_OF_GRIDS; };
+
+    for (uint32 x = 0; x < 128; x += 13)
+        for (uint32 y = 0; y < 128; y += 7)
+            EXPECT_EQ(_terrain.getLiquidLevel(squareCenter(x), squareCenter(y)), 10.0f + float((x * 128 + y) % 3));
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpellInfo.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // The effect queries the way SpellInfo answered them before the masks, one loop over the effects per call
+    struct EffectLoopQueries
+    {
+        static bool HasEffect(SpellInfo const* spellInfo, SpellEffects effect)
+        {
+            for (SpellEffectInfo const& effectInfo : spellInfo->GetEffects())
+                if (effectInfo.IsEffect(effect))
+                    return true;
+            return false;
+        }
+
+        static bool HasAura(SpellInfo const* spellInfo, AuraType aura)
+        {
+            for (SpellEffectInfo const& effectInfo : spellInfo->GetEffects())
+                if (effectInfo.IsAura(aura))
+                    return true;
+            return false;
+        }
+
+        static bool HasAnyAura(SpellInfo const* spellInfo)
+        {
+            for (SpellEffectInfo const& effectInfo : spellInfo->GetEffects())
+                if (effectInfo.IsAura())
+                    return true;
+            return false;
+        }
+
+        static bool HasAreaAuraEffect(SpellInfo const* spellInfo)
+        {
+            for (SpellEffectInfo const& effectInfo : spellInfo->GetEffects())
+                if (effectInfo.IsAreaAuraEffect())
+                    return true;
+            return false;
+        }
+
+        static bool HasEffectMechanic(SpellInfo const* spellInfo, Mechanics mechanic)
+        {
+            for (SpellEffectInfo const& effectInfo : spellInfo->GetEffects())
+                if (effectInfo.Mechanic == mechanic)
+                    return true;
+            return false;
+        }
+    };
+
+    struct EffectMaskQueries
+    {
+        static bool HasEffect(SpellInfo const* spellInfo, SpellEffects effect) { return spellInfo->HasEffect(effect); }
+        static bool HasAura(SpellInfo const* spellInfo, AuraType aura) { return spellInfo->HasAura(aura); }
+        static bool HasAnyAura(SpellInfo const* spellInfo) { return spellInfo->HasAnyAura(); }
+        static bool HasAreaAuraEffect(SpellInfo const* spellInfo) { return spellInfo->HasAreaAuraEffect(); }
+        static bool HasEffectMechanic(SpellInfo const* spellInfo, Mechanics mechanic) { return spellInfo->HasEffectMechanic(mechanic); }
+    };
+
+    // The effect queries made by Spell::prepare and Spell::CheckCast for one cast
+    template<class Queries>
+    uint32 CheckCastQueries(SpellInfo const* spellInfo)
+    {
+        uint32 result = 0;
+        result += Queries::HasEffect(spellInfo, SPELL_EFFECT_RESURRECT) || Queries::HasEffect(spellInfo, SPELL_EFFECT_RESURRECT_NEW);
+        result += Queries::HasAura(spellInfo, SPELL_AURA_MOUNTED);
+        result += Queries::HasAura(spellInfo, SPELL_AURA_MOD_INCREASE_MOUNTED_FLIGHT_SPEED);
+        result += Queries::HasEffect(spellInfo, SPELL_EFFECT_ADD_FARSIGHT);
+        result += Queries::HasEffect(spellInfo, SPELL_EFFECT_SUMMON_PET);
+        result += Queries::HasAura(spellInfo, SPELL_AURA_RETAIN_COMBO_POINTS);
+        result += Queries::HasEffect(spellInfo, SPELL_EFFECT_ADD_EXTRA_ATTACKS);
+        result += Queries::HasEffect(spellInfo, SPELL_EFFECT_ACTIVATE_RUNE);
+        result += Queries::HasAnyAura(spellInfo);
+        result += Queries::HasAreaAuraEffect(spellInfo);
+        result += Queries::HasEffectMechanic(spellInfo, MECHANIC_STUN);
+        return result;
+    }
+
+    class SpellInfoEffectMaskTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 random(7);
+            uint32 const effects[] =
+            {
+                0, SPELL_EFFECT_SCHOOL_DAMAGE, SPELL_EFFECT_APPLY_AURA, SPELL_EFFECT_HEAL, SPELL_EFFECT_DUMMY,
+                SPELL_EFFECT_PERSISTENT_AREA_AURA, SPELL_EFFECT_APPLY_AREA_AURA_RAID, SPELL_EFFECT_APPLY_AREA_AURA_ENEMY,
+                SPELL_EFFECT_RESURRECT, SPELL_EFFECT_ADD_FARSIGHT, SPELL_EFFECT_SUMMON_PET, SPELL_EFFECT_ACTIVATE_RUNE,
+            };
+            uint32 const auras[] =
+            {
+                SPELL_AURA_NONE, SPELL_AURA_MOUNTED, SPELL_AURA_PERIODIC_DAMAGE, SPELL_AURA_MOD_STUN,
+                SPELL_AURA_MOD_INCREASE_MOUNTED_FLIGHT_SPEED, SPELL_AURA_RETAIN_COMBO_POINTS, SPELL_AURA_DUMMY,
+            };
+            uint32 const mechanics[] = { MECHANIC_NONE, MECHANIC_NONE, MECHANIC_STUN, MECHANIC_ROOT, MECHANIC_BLEED };
+
+            for (uint32 i = 0; i < SPELL_COUNT; ++i)
+            {
+                SpellEntry entry = { };
+                entry.Id = i + 1;
+                for (uint8 j = 0; j < MAX_SPELL_EFFECTS; ++j)
+                {
+                    entry.Effect[j] = effects[random() % std::size(effects)];
+                    entry.EffectApplyAuraName[j] = auras[random() % std::size(auras)];
+                    entry.EffectMechanic[j] = mechanics[random() % std::size(mechanics)];
+                }
+
+                _spells.push_back(std::make_unique<SpellInfo>(&entry));
+            }
+        }
+
+        static constexpr uint32 SPELL_COUNT = 2048;
+
+        std::vector<std::unique_ptr<SpellInfo>> _spells;
+    };
+}
+
+TEST_F(SpellInfoEffectMaskTest, SameAnswersAsEffectLoop)
+{
+    for (std::unique_ptr<SpellInfo> const& spellInfo : _spells)
+    {
+        for (uint32 effect = 0; effect < TOTAL_SPELL_EFFECTS; ++effect)
+            EXPECT_EQ(spellInfo->HasEffect(SpellEffects(effect)), EffectLoopQueries::HasEffect(spellInfo.get(), SpellEffects(effect)));
+
+        for (uint32 aura = 0; aura < TOTAL_AURAS; ++aura)
+            EXPECT_EQ(spellInfo->HasAura(AuraType(aura)), EffectLoopQueries::HasAura(spellInfo.get(), AuraType(aura)));
+
+        for (uint32 mechanic = 0; mechanic < MAX_MECHANIC; ++mechanic)
+            EXPECT_EQ(spellInfo->HasEffectMechanic(Mechanics(mechanic)), EffectLoopQueries::HasEffectMechanic(spellInfo.get(), Mechanics(mechanic)));
+
+        EXPECT_EQ(spellInfo->HasAnyAura(), EffectLoopQueries::HasAnyAura(spellInfo.get()));
+        EXPECT_EQ(spellInfo->HasAreaAuraEffect(), EffectLoopQueries::HasAreaAuraEffect(spellInfo.get()));
+    }
+}
+
+TEST_F(SpellInfoEffectMaskTest, MasksFollowCorrections)
+{
+    SpellInfo* spellInfo = _spells.front().get();
+    spellInfo->Effects[EFFECT_0].Effect = SPELL_EFFECT_APPLY_AREA_AURA_PARTY;
+    spellInfo->Effects[EFFECT_0].ApplyAuraName = SPELL_AURA_MOD_SHAPESHIFT;
+    spellInfo->_InitializeEffectMasks();
+
+    EXPECT_TRUE(spellInfo->HasEffect(SPELL_EFFECT_APPLY_AREA_AURA_PARTY));
+    EXPECT_TRUE(spellInfo->HasAura(SPELL_AURA_MOD_SHAPESHIFT));
+    EXPECT_TRUE(spellInfo->HasAnyAura());
+    EXPECT_TRUE(spellInfo->HasAreaAuraEffect());
+}
+
+// Micro benchmark: the SpellInfo part of cast preparation, effect loops against the precomputed masks.
+// Spell::prepare itself needs a caster in a loaded map, which the unit tests can not provide.
+// Disabled so the unit test run does not time anything, run it on demand with
+// --gtest_also_run_disabled_tests --gtest_filter=SpellInfoEffectMaskTest.DISABLED_CastPreparationChecksPerSecond
+TEST_F(SpellInfoEffectMaskTest, DISABLED_CastPreparationChecksPerSecond)
+{
+    uint32 const rounds = 200;
+
+    auto measure = [&](auto checkCast)
+    {
+        uint64 found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 round = 0; round < rounds; ++round)
+            for (std::unique_ptr<SpellInfo> const& spellInfo : _spells)
+                found += checkCast(spellInfo.get());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return std::make_pair(found, double(rounds * _spells.size()) / std::max(elapsed.count(), 1e-9));
+    };
+
+    auto [loopFound, loopRate] = measure(CheckCastQueries<EffectLoopQueries>);
+    auto [maskFound, maskRate] = measure(CheckCastQueries<EffectMaskQueries>);
+
+    EXPECT_EQ(loopFound, maskFound);
+
+    std::cout << "[ BENCH    ] " << SPELL_COUNT << " spells: effect loops " << uint64(loopRate) << " casts/s, masks "
+        << uint64(maskRate) << " casts/s" << std::endl;
+    RecordProperty("EffectLoopCastsPerSecond", std::to_string(uint64(loopRate)));
+    RecordProperty("EffectMaskCastsPerSecond", std::to_string(uint64(maskRate)));
+}
@@ -17,11 +17,17 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <deque>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <cstring>
 
@@ -32,9 +38,12 @@
 #include <unistd.h>
 #endif
 
+#include "CryptoHash.h"
+#include "DataManifest.h"
 #include "dbcfile.h"
 #include "mpq_libmpq04.h"
 #include "StringFormat.h"
+#include "Util.h"
 
 #include "adt.h"
 #include "wdt.h"
@@ -99,6 +108,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of threads converting adt files
+uint32 CONF_threads = std::max(1u, std::thread::hardware_concurrency());
+
 // List MPQ for extract from
 const char* CONF_mpq_list[] =
 {
@@ -162,6 +174,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of threads converting map files - standard: number of cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -175,6 +188,7 @@ void HandleArgs(int argc, char* arg[])
         // e - extract only MAP(1)/DBC(2) - standard both(3)
         // f - use float to int conversion
         // h - limit minimum height
+        // t - number of conversion threads
         if (arg[c][0] != '-')
         {
             Usage(arg[0]);
@@ -214,6 +228,16 @@ void HandleArgs(int argc, char* arg[])
                     Usage(arg[0]);
                 }
                 break;
+            case 't':
+                if (c + 1 < argc)                           // all ok
+                {
+                    CONF_threads = std::max(1, atoi(arg[(c++) + 1]));
+                }
+                else
+                {
+                    Usage(arg[0]);
+                }
+                break;
             case 'e':
                 if (c + 1 < argc)                           // all ok
                 {
@@ -392,30 +416,30 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
-
-bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
+// Temporary grid data store, one per conversion thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
+
+bool ConvertADT(std::string const& inputPath, std::vector<uint8> const& inputData, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
     ADT_file adt;
 
-    if (!adt.loadFile(inputPath))
+    if (!adt.loadFromMemory(inputPath, inputData.data(), uint32(inputData.size())))
         return false;
 
     adt_MCIN* cells = adt.a_grid->getMCIN();
@@ -973,6 +997,77 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     return true;
 }
 
+// Settings that change the content of the converted map files
+std::string GetMapSettingsKey(uint32 build)
+{
+    std::string key = Acore::StringFormat("{} {} {} {} {} {} {} {} {}", build, MAP_VERSION_MAGIC, CONF_allow_height_limit, CONF_use_minHeight,
+        CONF_allow_float_to_int, CONF_float_to_int8_limit, CONF_float_to_int16_limit, CONF_flat_height_delta_limit, CONF_flat_liquid_delta_limit);
+
+    // liquid sound banks are written into the liquid flags
+    std::map<uint32, uint8> liquidTypes;
+    for (auto const& [id, liquidType] : LiquidTypes)
+        liquidTypes[id] = liquidType.SoundBank;
+
+    for (auto const& [id, soundBank] : liquidTypes)
+        key += Acore::StringFormat(" {}:{}", id, soundBank);
+
+    return key;
+}
+
+struct AdtConvertJob
+{
+    std::string MpqFileName;
+    std::string OutputFile;     // relative to the maps directory
+    std::string SourceHash;
+    std::vector<uint8> Data;
+    int CellY;
+    int CellX;
+};
+
+// Bounded job queue, ADT files are read from the MPQs by the main thread only
+// because libmpq is not thread safe
+class AdtConvertQueue
+{
+public:
+    explicit AdtConvertQueue(std::size_t maxSize) : _maxSize(maxSize) { }
+
+    void Push(AdtConvertJob&& job)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _notFull.wait(lock, [this] { return _jobs.size() < _maxSize; });
+        _jobs.push_back(std::move(job));
+        _notEmpty.notify_one();
+    }
+
+    bool Pop(AdtConvertJob& job)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        _notEmpty.wait(lock, [this] { return !_jobs.empty() || _finished; });
+        if (_jobs.empty())
+            return false;
+
+        job = std::move(_jobs.front());
+        _jobs.pop_front();
+        _notFull.notify_one();
+        return true;
+    }
+
+    void Finish()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _finished = true;
+        _notEmpty.notify_all();
+    }
+
+private:
+    std::mutex _lock;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+    std::deque<AdtConvertJob> _jobs;
+    std::size_t const _maxSize;
+    bool _finished = false;
+};
+
 void ExtractMapsFromMpq(uint32 build)
 {
     std::string mpqFileName;
@@ -989,7 +1084,41 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    // files of the previous run with unchanged input are kept as they are
+    std::string manifestPath = path + DataManifest::FILE_NAME;
+    DataManifest previousManifest;
+    if (previousManifest.Load(manifestPath))
+        printf("Loaded manifest of the previous extraction (%u files)\n", uint32(previousManifest.GetSize()));
+
+    DataManifest manifest;
+    std::string settingsKey = GetMapSettingsKey(build);
+    std::atomic<uint32> converted = 0;
+    uint32 skipped = 0;
+
+    printf("Convert map files using %u threads\n", CONF_threads);
+    AdtConvertQueue queue(CONF_threads * 4);
+    std::vector<std::thread> workers;
+    for (uint32 i = 0; i < CONF_threads; ++i)
+    {
+        workers.emplace_back([&]
+        {
+            AdtConvertJob job;
+            while (queue.Pop(job))
+            {
+                std::string outputPath = path + job.OutputFile;
+                if (!ConvertADT(job.MpqFileName, job.Data, outputPath, job.CellY, job.CellX, build))
+                    continue;
+
+                DataManifest::Entry entry;
+                entry.Size = std::filesystem::file_size(outputPath);
+                entry.Hash = DataManifest::HashFile(outputPath);
+                entry.SourceHash = job.SourceHash;
+                manifest.Set(job.OutputFile, entry);
+                ++converted;
+            }
+        });
+    }
+
     for (uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
@@ -1009,14 +1138,57 @@ void ExtractMapsFromMpq(uint32 build)
                 if (!wdt.main->adt_list[y][x].exist)
                     continue;
                 mpqFileName = Acore::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName = Acore::StringFormat("{}/maps/{:03}{:02}{:02}.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpqFileName, outputFileName, y, x, build);
+                outputFileName = Acore::StringFormat("{:03}{:02}{:02}.map", map_ids[z].id, y, x);
+
+                MPQFile mf(mpqFileName.c_str());
+                if (mf.isEof())
+                {
+                    printf("No such file %s\n", mpqFileName.c_str());
+                    continue;
+                }
+
+                AdtConvertJob job;
+                job.MpqFileName = mpqFileName;
+                job.OutputFile = outputFileName;
+                job.Data.resize(mf.getSize());
+                mf.read(job.Data.data(), job.Data.size());
+                mf.close();
+                job.CellY = y;
+                job.CellX = x;
+
+                Acore::Crypto::SHA256 sourceHash;
+                sourceHash.UpdateData(job.Data.data(), job.Data.size());
+                sourceHash.UpdateData(settingsKey);
+                sourceHash.Finalize();
+                job.SourceHash = ByteArrayToHexStr(sourceHash.GetDigest());
+
+                if (DataManifest::Entry const* entry = previousManifest.Find(outputFileName))
+                {
+                    std::error_code error;
+                    if (entry->SourceHash == job.SourceHash && std::filesystem::file_size(path + outputFileName, error) == entry->Size && !error)
+                    {
+                        manifest.Set(outputFileName, *entry);
+                        ++skipped;
+                        continue;
+                    }
+                }
+
+                queue.Push(std::move(job));
             }
             // draw progress bar
             printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
         }
     }
+
+    queue.Finish();
+    for (std::thread& worker : workers)
+        worker.join();
+
     printf("\n");
+    printf("Converted %u map files, %u unchanged files skipped\n", converted.load(), skipped);
+
+    if (!manifest.Save(manifestPath))
+        printf("Can't write the manifest file '%s'\n", manifestPath.c_str());
 }
 
 bool ExtractFile( char const* mpq_name, std::string const& filename )
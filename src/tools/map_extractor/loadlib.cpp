@@ -20,6 +20,7 @@
 #include "loadlib.h"
 #include "mpq_libmpq04.h"
 #include <cstdio>
+#include <cstring>
 
 class MPQFile;
 
@@ -62,6 +63,20 @@ bool FileLoader::loadFile(std::string const& fileName, bool log)
     return false;
 }
 
+bool FileLoader::loadFromMemory(std::string const& fileName, uint8 const* buffer, uint32 size)
+{
+    free();
+    data_size = size;
+    data = new uint8 [data_size];
+    memcpy(data, buffer, data_size);
+    if (prepareLoadedData())
+        return true;
+
+    printf("Error loading %s", fileName.c_str());
+    free();
+    return false;
+}
+
 bool FileLoader::prepareLoadedData()
 {
     // Check version
@@ -57,6 +57,8 @@ public:
     FileLoader();
     ~FileLoader();
     bool loadFile(std::string const& filename, bool log = true);
+    // Same as loadFile but uses file contents already read from the MPQ
+    bool loadFromMemory(std::string const& filename, uint8 const* buffer, uint32 size);
     virtual void free();
 };
 
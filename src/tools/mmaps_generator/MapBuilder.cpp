@@ -22,13 +22,22 @@
 #include "ModelInstance.h"
 #include "PathCommon.h"
 #include "StringFormat.h"
+#include "Timer.h"
+#include "Util.h"
 #include "VMapMgr2.h"
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <map>
 
 namespace MMAP
 {
+    static constexpr char const* CHECKPOINT_FILE_NAME = "mmaps/checkpoint.txt";
+    static constexpr char const* TIMING_REPORT_FILE_NAME = "mmaps/tile_timings.csv";
+    static constexpr std::size_t TIMING_REPORT_TILES = 20;
+
     TileBuilder::TileBuilder(MapBuilder* mapBuilder, bool skipLiquid, bool bigBaseUnit, bool debugOutput) :
             m_bigBaseUnit(bigBaseUnit),
             m_debugOutput(debugOutput),
@@ -105,7 +114,7 @@ namespace MMAP
         char filter[12];
 
         printf("Discovering maps... ");
-        getDirContents(files, "maps");
+        getDirContents(files, "maps", "*.map");
         for (auto & file : files)
         {
             mapID = uint32(atoi(file.substr(0, file.size() - 8).c_str()));
@@ -207,6 +216,8 @@ namespace MMAP
     {
         printf("Using %u threads to generate mmaps\n", m_threads);
 
+        openCheckpoint();
+
         for (unsigned int i = 0; i < m_threads; ++i)
         {
             m_tileBuilders.push_back(new TileBuilder(this, m_skipLiquid, m_bigBaseUnit, m_debugOutput));
@@ -226,6 +237,18 @@ namespace MMAP
             }
         }
 
+        // schedule the most expensive tiles first so a large continent
+        // does not leave a single thread working on its last tiles
+        std::stable_sort(m_pendingTiles.begin(), m_pendingTiles.end(), [](TileInfo const& left, TileInfo const& right)
+        {
+            return left.m_cost > right.m_cost;
+        });
+
+        for (TileInfo const& tileInfo : m_pendingTiles)
+            _queue.Push(tileInfo);
+
+        m_pendingTiles.clear();
+
         while (!_queue.Empty())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -239,6 +262,10 @@ namespace MMAP
             delete builder;
 
         m_tileBuilders.clear();
+
+        // a single map run leaves the tiles of the other maps in the checkpoint
+        closeCheckpoint(!mapID && !m_buildFailed);
+        printTimingReport();
     }
 
     /**************************************************************************/
@@ -405,17 +432,39 @@ namespace MMAP
             if (m_mapBuilder->_cancelationToken)
                 return;
 
+            // finished by an earlier, interrupted run
+            bool built = false;
+            if (m_mapBuilder->isTileCheckpointed(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY, built) &&
+                (!built || shouldSkipTile(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY)))
+            {
+                ++m_mapBuilder->m_totalTilesProcessed;
+                continue;
+            }
+
             dtNavMesh* navMesh = dtAllocNavMesh();
             if (!navMesh->init(&tileInfo.m_navMeshParams))
             {
                 printf("[Map %04i] Failed creating navmesh for tile %i,%i !\n", tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY);
+                m_mapBuilder->m_buildFailed = true;
                 dtFreeNavMesh(navMesh);
                 return;
             }
 
-            buildTile(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY, navMesh);
+            uint32 startTime = getMSTime();
+            bool success = buildTile(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY, navMesh);
+            uint32 buildTime = GetMSTimeDiffToNow(startTime);
 
             dtFreeNavMesh(navMesh);
+
+            // a failed tile stays out of the checkpoint so a resumed run builds it again
+            if (!success)
+            {
+                m_mapBuilder->m_buildFailed = true;
+                continue;
+            }
+
+            m_mapBuilder->markTileFinished(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY, buildTime,
+                shouldSkipTile(tileInfo.m_mapId, tileInfo.m_tileX, tileInfo.m_tileY));
         }
     }
 
@@ -432,6 +481,7 @@ namespace MMAP
             if (!navMesh)
             {
                 printf("[Map %03i] Failed creating navmesh!\n", mapID);
+                m_buildFailed = true;
                 m_totalTilesProcessed += tiles->size();
                 return;
             }
@@ -449,8 +499,9 @@ namespace MMAP
                 tileInfo.m_mapId = mapID;
                 tileInfo.m_tileX = tileX;
                 tileInfo.m_tileY = tileY;
+                tileInfo.m_cost = estimateTileCost(mapID, tileX, tileY);
                 memcpy(&tileInfo.m_navMeshParams, navMesh->getParams(), sizeof(dtNavMeshParams));
-                _queue.Push(tileInfo);
+                m_pendingTiles.push_back(tileInfo);
             }
 
             dtFreeNavMesh(navMesh);
@@ -458,12 +509,12 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    bool TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
         if (shouldSkipTile(mapID, tileX, tileY))
         {
             ++m_mapBuilder->m_totalTilesProcessed;
-            return;
+            return true;
         }
 
         printf("%u%% [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), mapID, tileX, tileY);
@@ -480,7 +531,7 @@ namespace MMAP
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
         {
             ++m_mapBuilder->m_totalTilesProcessed;
-            return;
+            return true;
         }
 
         // remove unused vertices
@@ -495,7 +546,7 @@ namespace MMAP
         if (!allVerts.size())
         {
             ++m_mapBuilder->m_totalTilesProcessed;
-            return;
+            return true;
         }
 
         // get bounds of current tile
@@ -505,9 +556,10 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_mapBuilder->m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        bool success = buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
 
         ++m_mapBuilder->m_totalTilesProcessed;
+        return success;
     }
 
     /**************************************************************************/
@@ -586,7 +638,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
+    bool TileBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                       MeshData& meshData, float bmin[3], float bmax[3],
                                       dtNavMesh* navMesh)
     {
@@ -595,6 +647,9 @@ namespace MMAP
         sprintf(tileString, "[Map %03i] [%02i,%02i]: ", mapID, tileX, tileY);
         printf("%s Building movemap tiles...\n", tileString);
 
+        // "No ..." below means the tile has no walkable geometry, every other early out is a failure
+        bool success = true;
+
         IntermediateValues iv;
 
         float* tVerts = meshData.solidVerts.getCArray();
@@ -651,6 +706,7 @@ namespace MMAP
                 if (!tile.solid || !rcCreateHeightfield(m_rcContext, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
                 {
                     printf("%s Failed building heightfield!            \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -674,6 +730,7 @@ namespace MMAP
                 if (!tile.chf || !rcBuildCompactHeightfield(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
                 {
                     printf("%s Failed compacting heightfield!            \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -681,18 +738,21 @@ namespace MMAP
                 if (!rcErodeWalkableArea(m_rcContext, config.walkableRadius, *tile.chf))
                 {
                     printf("%s Failed eroding area!                    \n", tileString);
+                    success = false;
                     continue;
                 }
 
                 if (!rcBuildDistanceField(m_rcContext, *tile.chf))
                 {
                     printf("%s Failed building distance field!         \n", tileString);
+                    success = false;
                     continue;
                 }
 
                 if (!rcBuildRegions(m_rcContext, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
                 {
                     printf("%s Failed building regions!                \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -700,6 +760,7 @@ namespace MMAP
                 if (!tile.cset || !rcBuildContours(m_rcContext, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
                 {
                     printf("%s Failed building contours!               \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -708,6 +769,7 @@ namespace MMAP
                 if (!tile.pmesh || !rcBuildPolyMesh(m_rcContext, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
                 {
                     printf("%s Failed building polymesh!               \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -715,6 +777,7 @@ namespace MMAP
                 if (!tile.dmesh || !rcBuildPolyMeshDetail(m_rcContext, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg.detailSampleMaxError, *tile.dmesh))
                 {
                     printf("%s Failed building polymesh detail!        \n", tileString);
+                    success = false;
                     continue;
                 }
 
@@ -741,7 +804,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return false;
         }
         rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
 
@@ -752,7 +815,7 @@ namespace MMAP
             delete[] pmmerge;
             delete[] dmmerge;
             delete[] tiles;
-            return;
+            return false;
         }
         rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
 
@@ -813,11 +876,13 @@ namespace MMAP
             if (params.nvp > DT_VERTS_PER_POLYGON)
             {
                 printf("%s Invalid verts-per-polygon value!        \n", tileString);
+                success = false;
                 break;
             }
             if (params.vertCount >= 0xffff)
             {
                 printf("%s Too many vertices!                      \n", tileString);
+                success = false;
                 break;
             }
             if (!params.vertCount || !params.verts)
@@ -846,6 +911,7 @@ namespace MMAP
             if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
             {
                 printf("%s Failed building navmesh tile!           \n", tileString);
+                success = false;
                 break;
             }
 
@@ -857,19 +923,23 @@ namespace MMAP
             if (!tileRef || dtResult != DT_SUCCESS)
             {
                 printf("%s Failed adding tile to navmesh!           \n", tileString);
+                success = false;
                 break;
             }
 
-            // file output
+            // file output, written to a temporary file first so an interrupted
+            // run never leaves a truncated tile that looks complete
             char fileName[255];
             sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
-            FILE* file = fopen(fileName, "wb");
+            std::string tempFileName = std::string(fileName) + ".tmp";
+            FILE* file = fopen(tempFileName.c_str(), "wb");
             if (!file)
             {
                 char message[1024];
-                sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, fileName);
+                sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, tempFileName.c_str());
                 perror(message);
                 navMesh->removeTile(tileRef, nullptr, nullptr);
+                success = false;
                 break;
             }
 
@@ -885,6 +955,14 @@ namespace MMAP
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
+            boost::system::error_code error;
+            boost::filesystem::rename(tempFileName, fileName, error);
+            if (error)
+            {
+                printf("%s Failed to rename %s: %s\n", tileString, tempFileName.c_str(), error.message().c_str());
+                success = false;
+            }
+
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, nullptr, nullptr);
         } while (false);
@@ -902,6 +980,8 @@ namespace MMAP
             iv.generateObjFile(mapID, tileX, tileY, meshData);
             iv.writeIV(mapID, tileX, tileY);
         }
+
+        return success;
     }
 
     /**************************************************************************/
@@ -1107,4 +1187,148 @@ namespace MMAP
     {
         return percentageDone(m_totalTiles, m_totalTilesProcessed);
     }
+
+    uint64 MapBuilder::estimateTileCost(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        char fileName[255];
+        uint64 cost = 0;
+        boost::system::error_code error;
+
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
+        uintmax_t size = boost::filesystem::file_size(fileName, error);
+        if (!error)
+            cost += size;
+
+        // model data is far more expensive to rasterize than the height map
+        sprintf(fileName, "vmaps/%03u_%02u_%02u.vmtile", mapID, tileY, tileX);
+        size = boost::filesystem::file_size(fileName, error);
+        if (!error)
+            cost += size * 4;
+
+        return cost;
+    }
+
+    std::string MapBuilder::getCheckpointHeader() const
+    {
+        // tiles of a run with different settings can not be reused
+        return Acore::StringFormat("mmaps_generator checkpoint mmap:{} detour:{} maxAngle:{} skipLiquid:{} bigBaseUnit:{}",
+            MMAP_VERSION, DT_NAVMESH_VERSION, m_maxWalkableAngle, m_skipLiquid, m_bigBaseUnit);
+    }
+
+    void MapBuilder::openCheckpoint()
+    {
+        std::string header = getCheckpointHeader();
+        std::string line;
+
+        std::ifstream input(CHECKPOINT_FILE_NAME);
+        bool resume = input && std::getline(input, line) && line == header;
+        if (resume)
+        {
+            while (std::getline(input, line))
+            {
+                uint32 mapID, tileX, tileY, built, buildTime;
+                // the last line may be incomplete if the run was killed
+                if (sscanf(line.c_str(), "%u %u %u %u %u", &mapID, &tileX, &tileY, &built, &buildTime) != 5)
+                    continue;
+
+                m_checkpointTiles[uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY)] = built != 0;
+            }
+        }
+
+        input.close();
+
+        m_checkpointFile = fopen(CHECKPOINT_FILE_NAME, resume ? "a" : "w");
+        if (!m_checkpointFile)
+        {
+            printf("Failed to open %s, the run can not be resumed if it is interrupted\n", CHECKPOINT_FILE_NAME);
+            return;
+        }
+
+        if (resume)
+            printf("Resuming: %u tiles were finished by an earlier run\n", uint32(m_checkpointTiles.size()));
+        else
+            fprintf(m_checkpointFile, "%s\n", header.c_str());
+
+        fflush(m_checkpointFile);
+    }
+
+    void MapBuilder::closeCheckpoint(bool completed)
+    {
+        if (m_checkpointFile)
+        {
+            fclose(m_checkpointFile);
+            m_checkpointFile = nullptr;
+        }
+
+        if (!completed)
+            return;
+
+        // nothing left to resume, the next run has to start from scratch
+        boost::system::error_code error;
+        boost::filesystem::remove(CHECKPOINT_FILE_NAME, error);
+        if (error)
+            printf("Failed to remove %s: %s\n", CHECKPOINT_FILE_NAME, error.message().c_str());
+    }
+
+    bool MapBuilder::isTileCheckpointed(uint32 mapID, uint32 tileX, uint32 tileY, bool& built) const
+    {
+        // only filled before the workers start
+        auto itr = m_checkpointTiles.find(uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY));
+        if (itr == m_checkpointTiles.end())
+            return false;
+
+        built = itr->second;
+        return true;
+    }
+
+    void MapBuilder::markTileFinished(uint32 mapID, uint32 tileX, uint32 tileY, uint32 buildTime, bool built)
+    {
+        std::lock_guard<std::mutex> guard(m_checkpointLock);
+
+        m_tileTimings.push_back({ mapID, tileX, tileY, buildTime, built });
+
+        if (m_checkpointFile)
+        {
+            fprintf(m_checkpointFile, "%u %u %u %u %u\n", mapID, tileX, tileY, built ? 1 : 0, buildTime);
+            fflush(m_checkpointFile);
+        }
+    }
+
+    void MapBuilder::printTimingReport() const
+    {
+        if (m_tileTimings.empty())
+            return;
+
+        std::vector<TileTiming> timings = m_tileTimings;
+        std::sort(timings.begin(), timings.end(), [](TileTiming const& left, TileTiming const& right)
+        {
+            return left.m_buildTime > right.m_buildTime;
+        });
+
+        std::map<uint32, std::pair<uint64, uint32>> mapTimes; // map id -> total build time, tile count
+        for (TileTiming const& timing : timings)
+        {
+            mapTimes[timing.m_mapId].first += timing.m_buildTime;
+            ++mapTimes[timing.m_mapId].second;
+        }
+
+        printf("\nSlowest tiles:\n");
+        for (std::size_t i = 0; i < timings.size() && i < TIMING_REPORT_TILES; ++i)
+            printf("  [Map %04u] tile [%02u,%02u] %u ms\n", timings[i].m_mapId, timings[i].m_tileX, timings[i].m_tileY, timings[i].m_buildTime);
+
+        printf("\nBuild time per map (summed over all threads):\n");
+        for (auto const& [mapID, mapTime] : mapTimes)
+            printf("  [Map %04u] %u tiles in %s\n", mapID, mapTime.second, secsToTimeString(mapTime.first / 1000).c_str());
+
+        FILE* file = fopen(TIMING_REPORT_FILE_NAME, "w");
+        if (!file)
+            return;
+
+        fprintf(file, "map,tileX,tileY,built,milliseconds\n");
+        for (TileTiming const& timing : timings)
+            fprintf(file, "%u,%u,%u,%u,%u\n", timing.m_mapId, timing.m_tileX, timing.m_tileY, timing.m_built ? 1 : 0, timing.m_buildTime);
+
+        fclose(file);
+        printf("\nTimings of all %u built tiles were written to %s\n", uint32(timings.size()), TIMING_REPORT_FILE_NAME);
+    }
 }
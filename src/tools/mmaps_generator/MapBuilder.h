@@ -20,8 +20,10 @@
 
 #include <atomic>
 #include <list>
+#include <mutex>
 #include <set>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Optional.h"
@@ -94,12 +96,23 @@ namespace MMAP
 
     struct TileInfo
     {
-        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams() {}
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams(), m_cost(0) {}
 
         uint32 m_mapId;
         uint32 m_tileX;
         uint32 m_tileY;
         dtNavMeshParams m_navMeshParams;
+        uint64 m_cost; // estimated build cost, size of the tile's input data
+    };
+
+    // a tile finished in this run, used for the checkpoint file and the timing report
+    struct TileTiming
+    {
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+        uint32 m_buildTime; // milliseconds
+        bool m_built;       // false if the tile had no data and no mmtile was written
     };
 
     /// @todo: move this to its own file. For now it will stay here to keep the changes to a minimum, especially in the cpp file
@@ -118,9 +131,10 @@ namespace MMAP
         void WorkerThread();
         void WaitCompletion();
 
-        void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+        // false if the tile has geometry but no .mmtile could be written for it
+        bool buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
         // move map building
-        void buildMoveMapTile(uint32 mapID,
+        bool buildMoveMapTile(uint32 mapID,
                               uint32 tileX,
                               uint32 tileY,
                               MeshData& meshData,
@@ -167,8 +181,10 @@ namespace MMAP
         void buildMaps(Optional<uint32> mapID);
 
     private:
-        // builds all mmap tiles for the specified map id (ignores skip settings)
+        // queues all mmap tiles for the specified map id (ignores skip settings)
         void buildMap(uint32 mapID);
+        // estimates the build cost of a tile from the size of its map and vmap data
+        uint64 estimateTileCost(uint32 mapID, uint32 tileX, uint32 tileY) const;
         // detect maps and tiles
         void discoverTiles();
         std::set<uint32>* getTileList(uint32 mapID);
@@ -189,6 +205,17 @@ namespace MMAP
         uint32 percentageDone(uint32 totalTiles, uint32 totalTilesDone) const;
         uint32 currentPercentageDone() const;
 
+        // checkpoint of finished tiles, an interrupted run continues where it stopped
+        std::string getCheckpointHeader() const;
+        void openCheckpoint();
+        // the checkpoint is only removed once every requested map was built without errors
+        void closeCheckpoint(bool completed);
+        // true if an earlier run with the same settings finished the tile
+        bool isTileCheckpointed(uint32 mapID, uint32 tileX, uint32 tileY, bool& built) const;
+        void markTileFinished(uint32 mapID, uint32 tileX, uint32 tileY, uint32 buildTime, bool built);
+        // prints the slowest tiles and the build time per map, writes all tile timings to a file
+        void printTimingReport() const;
+
         TerrainBuilder* m_terrainBuilder{nullptr};
         TileList m_tiles;
 
@@ -214,6 +241,15 @@ namespace MMAP
         std::vector<TileBuilder*> m_tileBuilders;
         ProducerConsumerQueue<TileInfo> _queue;
         std::atomic<bool> _cancelationToken;
+
+        // tiles of all requested maps, queued largest first once every map is known
+        std::vector<TileInfo> m_pendingTiles;
+
+        std::mutex m_checkpointLock;
+        FILE* m_checkpointFile{nullptr};
+        std::unordered_map<uint64, bool> m_checkpointTiles; // finished in an earlier run -> mmtile written
+        std::atomic<bool> m_buildFailed{false};              // a navmesh or tile could not be built
+        std::vector<TileTiming> m_tileTimings;
     };
 }
 